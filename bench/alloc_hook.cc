@@ -0,0 +1,67 @@
+// Global operator new/delete with an allocation counter, linked into
+// every bench binary. Counting here instead of interposing malloc keeps
+// the hook inside the normal build (no LD_PRELOAD on the device) while
+// still catching every hot-path C++ allocation; the harness diffs the
+// counter around each run.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "perf_counters.h"
+
+namespace exynos::bench {
+
+namespace {
+std::atomic<std::uint64_t> g_allocations{0};
+}
+
+std::uint64_t allocation_count() {
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+namespace detail {
+void* counted_alloc(std::size_t size, std::size_t align) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p;
+  if (align <= alignof(std::max_align_t)) {
+    p = std::malloc(size);
+  } else {
+    // aligned_alloc wants the size rounded to the alignment.
+    p = std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+  }
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+}  // namespace detail
+
+}  // namespace exynos::bench
+
+void* operator new(std::size_t size) {
+  return exynos::bench::detail::counted_alloc(size, 0);
+}
+void* operator new[](std::size_t size) {
+  return exynos::bench::detail::counted_alloc(size, 0);
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+  return exynos::bench::detail::counted_alloc(
+      size, static_cast<std::size_t>(align));
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+  return exynos::bench::detail::counted_alloc(
+      size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
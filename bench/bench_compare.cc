@@ -0,0 +1,135 @@
+// Regression gate over two --json outputs from the bench harness:
+//
+//   bench_compare baseline.json current.json [--threshold=0.10]
+//
+// Every benchmark present in both files is compared metric by metric:
+// ns_per_iter and the per-iteration counter metrics (cycles, cache
+// misses, allocations, ...) must not grow past baseline * (1 +
+// threshold), and bytes_per_sec must not shrink past baseline * (1 -
+// threshold). A zero baseline is a hard gate — a benchmark that did not
+// allocate may never start allocating, whatever the threshold. Exits 1
+// when anything regressed, 2 on usage or parse errors, so CI can tell
+// "slower" apart from "broken".
+//
+// The result files are one benchmark object per line, so each line
+// parses with the same jsonl parser the ingest path uses.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "exynos/jsonl/parser.h"
+
+namespace {
+
+using Metrics = std::map<std::string, double>;
+
+// name -> metrics, in file order for stable reporting.
+bool load_results(const char* path, std::vector<std::pair<std::string, Metrics>>& out) {
+  std::ifstream in(path);
+  if (!in) {
+    std::fprintf(stderr, "bench_compare: cannot read %s\n", path);
+    return false;
+  }
+  std::string line;
+  exynos::jsonl::Record rec;
+  while (std::getline(in, line)) {
+    std::size_t begin = line.find('{');
+    if (begin == std::string::npos || line.find("\"name\"") == std::string::npos)
+      continue;
+    std::size_t end = line.rfind('}');
+    if (end == std::string::npos || end < begin) continue;
+    if (!exynos::jsonl::parse_record(
+            std::string_view(line).substr(begin, end - begin + 1), rec)) {
+      std::fprintf(stderr, "bench_compare: bad line in %s: %s\n", path,
+                   line.c_str());
+      return false;
+    }
+    const exynos::jsonl::Value* name = rec.find("name");
+    if (name == nullptr || name->type != exynos::jsonl::ValueType::String)
+      continue;
+    Metrics metrics;
+    for (const exynos::jsonl::Field& f : rec.fields) {
+      if (f.value.type == exynos::jsonl::ValueType::Int)
+        metrics[std::string(f.key)] = static_cast<double>(f.value.i);
+      else if (f.value.type == exynos::jsonl::ValueType::Double)
+        metrics[std::string(f.key)] = f.value.d;
+    }
+    out.emplace_back(std::string(name->s), std::move(metrics));
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* baseline_path = nullptr;
+  const char* current_path = nullptr;
+  double threshold = 0.10;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--threshold=", 12) == 0)
+      threshold = std::atof(argv[i] + 12);
+    else if (baseline_path == nullptr)
+      baseline_path = argv[i];
+    else if (current_path == nullptr)
+      current_path = argv[i];
+  }
+  if (baseline_path == nullptr || current_path == nullptr) {
+    std::fprintf(stderr,
+                 "usage: bench_compare BASELINE.json CURRENT.json "
+                 "[--threshold=0.10]\n");
+    return 2;
+  }
+
+  std::vector<std::pair<std::string, Metrics>> baseline_list, current_list;
+  if (!load_results(baseline_path, baseline_list) ||
+      !load_results(current_path, current_list))
+    return 2;
+  std::map<std::string, Metrics> baseline(baseline_list.begin(),
+                                          baseline_list.end());
+
+  int regressions = 0;
+  for (const auto& [name, current] : current_list) {
+    const auto base_it = baseline.find(name);
+    if (base_it == baseline.end()) {
+      std::printf("%-40s (new, no baseline)\n", name.c_str());
+      continue;
+    }
+    for (const auto& [metric, cur] : current) {
+      if (metric == "iterations") continue;  // auto-scaled, not a metric
+      const auto m = base_it->second.find(metric);
+      if (m == base_it->second.end()) continue;
+      const double base = m->second;
+
+      const bool higher_better = metric == "bytes_per_sec";
+      bool regressed;
+      if (higher_better)
+        regressed = cur < base * (1.0 - threshold);
+      else if (base == 0.0)
+        regressed = cur > 1e-9;  // zero stays zero, no slack
+      else
+        regressed = cur > base * (1.0 + threshold);
+
+      const double delta =
+          base != 0.0 ? (cur - base) / base * 100.0 : (cur != 0.0 ? 100.0 : 0.0);
+      if (regressed) {
+        std::printf("%-40s %-24s %14.3f -> %14.3f  %+7.1f%%  REGRESSED\n",
+                    name.c_str(), metric.c_str(), base, cur, delta);
+        ++regressions;
+      }
+    }
+  }
+
+  if (regressions != 0) {
+    std::fprintf(stderr, "bench_compare: %d metric(s) regressed beyond %.0f%%\n",
+                 regressions, threshold * 100.0);
+    return 1;
+  }
+  std::printf("bench_compare: no regressions beyond %.0f%% (%zu benchmarks)\n",
+              threshold * 100.0, current_list.size());
+  return 0;
+}
@@ -0,0 +1,71 @@
+#include <string>
+#include <vector>
+
+#include "exynos/index/id_map.h"
+#include "harness.h"
+
+namespace {
+
+using exynos::bench::State;
+using exynos::index::IdMap;
+
+constexpr int kIds = 200000;
+
+const IdMap& built_map() {
+  static const IdMap map = [] {
+    IdMap m;
+    m.reserve(kIds);
+    for (int i = 0; i < kIds; ++i)
+      m.insert("req-" + std::to_string(i), static_cast<std::uint64_t>(i) * 64);
+    return m;
+  }();
+  return map;
+}
+
+const std::vector<std::uint64_t>& probe_hashes() {
+  static const std::vector<std::uint64_t> hashes = [] {
+    std::vector<std::uint64_t> h;
+    h.reserve(kIds);
+    for (int i = 0; i < kIds; ++i)
+      h.push_back(IdMap::hash("req-" + std::to_string(i)));
+    return h;
+  }();
+  return hashes;
+}
+
+void bm_index_build(State& state) {
+  for (auto _ : state) {
+    IdMap m;
+    m.reserve(kIds);
+    for (int i = 0; i < kIds; ++i)
+      m.insert_hash(probe_hashes()[static_cast<std::size_t>(i)],
+                    static_cast<std::uint64_t>(i));
+  }
+  state.set_metric("ids", kIds);
+}
+
+void bm_index_lookup_hit(State& state) {
+  const IdMap& map = built_map();
+  std::uint64_t sink = 0;
+  for (auto _ : state)
+    for (std::uint64_t h : probe_hashes()) sink += *map.find_hash(h);
+  state.set_metric("lookups_per_iter", kIds);
+  state.set_metric("sink", static_cast<double>(sink & 1));
+}
+
+void bm_index_lookup_miss(State& state) {
+  const IdMap& map = built_map();
+  std::uint64_t hits = 0;
+  for (auto _ : state)
+    for (std::uint64_t h : probe_hashes())
+      if (map.find_hash(h ^ 0xDEADBEEF)) ++hits;
+  state.set_metric("lookups_per_iter", kIds);
+  state.set_metric("false_hits", static_cast<double>(hits));
+}
+
+}  // namespace
+
+EXYNOS_BENCHMARK(bm_index_build);
+EXYNOS_BENCHMARK(bm_index_lookup_hit);
+EXYNOS_BENCHMARK(bm_index_lookup_miss);
+EXYNOS_BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+#include <string_view>
+#include <vector>
+
+#include "exynos/jsonl/parser.h"
+#include "exynos/jsonl/schema.h"
+#include "harness.h"
+#include "synth.h"
+
+namespace {
+
+using exynos::bench::State;
+using exynos::bench::Synth;
+using exynos::bench::SynthOptions;
+
+struct Corpus {
+  std::string data;
+  std::vector<std::string_view> lines;
+};
+
+const Corpus& corpus(std::uint32_t extra_fields) {
+  static Corpus small = [] {
+    SynthOptions opts;
+    opts.records = 20000;
+    return Corpus{Synth::generate(opts), {}};
+  }();
+  static Corpus wide = [] {
+    SynthOptions opts;
+    opts.records = 20000;
+    opts.extra_fields = 12;
+    return Corpus{Synth::generate(opts), {}};
+  }();
+  Corpus& c = extra_fields == 0 ? small : wide;
+  if (c.lines.empty()) {
+    std::string_view rest = c.data;
+    while (!rest.empty()) {
+      auto nl = rest.find('\n');
+      c.lines.push_back(rest.substr(0, nl));
+      rest.remove_prefix(nl + 1);
+    }
+  }
+  return c;
+}
+
+void parse_corpus(State& state, std::uint32_t extra_fields) {
+  const Corpus& c = corpus(extra_fields);
+  exynos::jsonl::Record scratch;
+  std::uint64_t fields = 0;
+  for (auto _ : state) {
+    for (std::string_view line : c.lines) {
+      exynos::jsonl::parse_record(line, scratch);
+      fields += scratch.fields.size();
+    }
+  }
+  state.set_bytes_per_iter(c.data.size());
+  state.set_metric("fields", static_cast<double>(fields / state.iterations()));
+}
+
+void bm_parse_narrow(State& state) { parse_corpus(state, 0); }
+void bm_parse_wide(State& state) { parse_corpus(state, 12); }
+
+struct SynthRow {
+  std::string_view id;
+  std::string_view endpoint;
+  std::int64_t latency_ms;
+  std::int64_t ts;
+};
+
+using SynthSchema =
+    exynos::jsonl::Schema<exynos::jsonl::SchemaField<"id", &SynthRow::id>,
+                          exynos::jsonl::SchemaField<"endpoint", &SynthRow::endpoint>,
+                          exynos::jsonl::SchemaField<"latency_ms",
+                                               &SynthRow::latency_ms>,
+                          exynos::jsonl::SchemaField<"ts", &SynthRow::ts>>;
+
+// Same corpus as bm_parse_narrow through the compile-time schema, with
+// the generic parser as the (never-taken here) mismatch fallback.
+void bm_parse_schema(State& state) {
+  const Corpus& c = corpus(0);
+  exynos::jsonl::Record scratch;
+  std::uint64_t fallbacks = 0;
+  std::int64_t latency_sum = 0;
+  for (auto _ : state) {
+    for (std::string_view line : c.lines) {
+      SynthRow row;
+      if (SynthSchema::parse(line, row)) {
+        latency_sum += row.latency_ms;
+      } else {
+        ++fallbacks;
+        exynos::jsonl::parse_record(line, scratch);
+      }
+    }
+  }
+  state.set_bytes_per_iter(c.data.size());
+  state.set_metric("fallbacks",
+                   static_cast<double>(fallbacks / state.iterations()));
+}
+
+}  // namespace
+
+EXYNOS_BENCHMARK(bm_parse_narrow);
+EXYNOS_BENCHMARK(bm_parse_wide);
+EXYNOS_BENCHMARK(bm_parse_schema);
+EXYNOS_BENCHMARK_MAIN();
@@ -0,0 +1,51 @@
+#include <thread>
+
+#include "exynos/ingest/pipeline.h"
+#include "harness.h"
+#include "synth.h"
+
+namespace {
+
+using exynos::bench::State;
+using exynos::bench::Synth;
+using exynos::bench::SynthOptions;
+using exynos::ingest::ParsedChunk;
+using exynos::ingest::Pipeline;
+using exynos::ingest::PipelineOptions;
+
+const std::string& data() {
+  static const std::string d = [] {
+    SynthOptions opts;
+    opts.records = 100000;
+    opts.extra_fields = 4;
+    return Synth::generate(opts);
+  }();
+  return d;
+}
+
+void run_with_workers(State& state, unsigned workers) {
+  PipelineOptions opts;
+  opts.workers = workers;
+  opts.chunk_bytes = std::size_t{1} << 20;
+  Pipeline pipeline(opts);
+  std::uint64_t records = 0;
+  for (auto _ : state) {
+    records = 0;
+    pipeline.run(data(),
+                 [&](ParsedChunk&& chunk) { records += chunk.records.size(); });
+  }
+  state.set_bytes_per_iter(data().size());
+  state.set_metric("records", static_cast<double>(records));
+}
+
+void bm_pipeline_1_worker(State& state) { run_with_workers(state, 1); }
+
+void bm_pipeline_all_cores(State& state) {
+  run_with_workers(state, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+EXYNOS_BENCHMARK(bm_pipeline_1_worker);
+EXYNOS_BENCHMARK(bm_pipeline_all_cores);
+EXYNOS_BENCHMARK_MAIN();
@@ -0,0 +1,79 @@
+#include <string>
+#include <vector>
+
+#include "exynos/jsonl/simd_scanner.h"
+#include "exynos/jsonl/simd_text.h"
+#include "harness.h"
+#include "synth.h"
+
+namespace {
+
+using exynos::bench::State;
+using exynos::bench::Synth;
+using exynos::bench::SynthOptions;
+using exynos::jsonl::ScalarScanPolicy;
+using exynos::jsonl::SimdScanner;
+
+const std::string& data() {
+  static const std::string d = [] {
+    SynthOptions opts;
+    opts.records = 50000;
+    opts.payload_bytes = 64;
+    return Synth::generate(opts);
+  }();
+  return d;
+}
+
+void bm_find_newlines(State& state) {
+  std::vector<std::uint64_t> out;
+  for (auto _ : state) {
+    out.clear();
+    SimdScanner<>::find_newlines(data(), out);
+  }
+  state.set_bytes_per_iter(data().size());
+  state.set_metric("records", static_cast<double>(data().size()));
+}
+
+void bm_find_newlines_scalar(State& state) {
+  std::vector<std::uint64_t> out;
+  for (auto _ : state) {
+    out.clear();
+    SimdScanner<ScalarScanPolicy>::find_newlines(data(), out);
+  }
+  state.set_bytes_per_iter(data().size());
+}
+
+void bm_find_quotes(State& state) {
+  std::vector<std::uint64_t> out;
+  for (auto _ : state) {
+    out.clear();
+    SimdScanner<>::find_char(data(), '"', out);
+  }
+  state.set_bytes_per_iter(data().size());
+}
+
+void bm_validate_utf8(State& state) {
+  bool ok = true;
+  for (auto _ : state) ok &= exynos::jsonl::simd_validate_utf8(data());
+  state.set_bytes_per_iter(data().size());
+  state.set_metric("valid", ok ? 1 : 0);
+}
+
+void bm_unescape(State& state) {
+  // Synth payloads carry no escapes, so this measures the bulk-copy fast
+  // path — the one the compliance pass pays on real log strings.
+  std::string out;
+  bool ok = true;
+  for (auto _ : state) ok &= exynos::jsonl::simd_unescape(data(), out);
+  state.set_bytes_per_iter(data().size());
+  state.set_metric("ok", ok ? 1 : 0);
+}
+
+}  // namespace
+
+EXYNOS_BENCHMARK(bm_find_newlines);
+EXYNOS_BENCHMARK(bm_find_newlines_scalar);
+EXYNOS_BENCHMARK(bm_find_quotes);
+EXYNOS_BENCHMARK(bm_validate_utf8);
+EXYNOS_BENCHMARK(bm_unescape);
+EXYNOS_BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+#include "harness.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include "perf_counters.h"
+
+namespace exynos::bench {
+
+namespace {
+
+struct Entry {
+  const char* name;
+  BenchFn fn;
+};
+
+std::vector<Entry>& registry() {
+  static std::vector<Entry> entries;
+  return entries;
+}
+
+double now_seconds() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void emit_json(const std::vector<Result>& results, const char* path) {
+  std::FILE* f = std::fopen(path, "w");
+  if (f == nullptr) {
+    std::fprintf(stderr, "cannot write %s\n", path);
+    return;
+  }
+  std::fprintf(f, "{\n  \"benchmarks\": [\n");
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    std::fprintf(f,
+                 "    {\"name\": \"%s\", \"iterations\": %llu, "
+                 "\"ns_per_iter\": %.3f, \"bytes_per_sec\": %.0f",
+                 r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+                 r.ns_per_iter, r.bytes_per_sec);
+    for (const auto& [name, value] : r.metrics)
+      std::fprintf(f, ", \"%s\": %.6f", name.c_str(), value);
+    std::fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(f, "  ]\n}\n");
+  std::fclose(f);
+}
+
+}  // namespace
+
+void register_benchmark(const char* name, BenchFn fn) {
+  registry().push_back({name, fn});
+}
+
+int run_benchmarks(int argc, char** argv) {
+  const char* json_path = nullptr;
+  const char* filter = nullptr;
+  double min_time = 0.2;
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg = argv[i];
+    if (arg.rfind("--json=", 0) == 0) json_path = argv[i] + 7;
+    if (arg.rfind("--filter=", 0) == 0) filter = argv[i] + 9;
+    if (arg.rfind("--min-time=", 0) == 0) min_time = std::atof(argv[i] + 11);
+  }
+
+  std::vector<Result> results;
+  for (const Entry& e : registry()) {
+    if (filter != nullptr && std::strstr(e.name, filter) == nullptr) continue;
+    // Scale iterations until the run is long enough to time reliably.
+    std::uint64_t iters = 1;
+    Result result;
+    PerfCounters counters;
+    for (;;) {
+      State state(iters);
+      const std::uint64_t allocs_before = allocation_count();
+      counters.start();
+      const double t0 = now_seconds();
+      e.fn(state);
+      const double elapsed = now_seconds() - t0;
+      counters.stop();
+      const std::uint64_t allocs =
+          allocation_count() - allocs_before;
+      if (elapsed >= min_time || iters >= (std::uint64_t{1} << 40)) {
+        result.name = e.name;
+        result.iterations = iters;
+        result.ns_per_iter = elapsed * 1e9 / static_cast<double>(iters);
+        if (state.bytes_per_iter() != 0)
+          result.bytes_per_sec =
+              static_cast<double>(state.bytes_per_iter()) *
+              static_cast<double>(iters) / elapsed;
+        result.metrics = state.metrics();
+        // Counter metrics normalize per iteration so baselines compare
+        // across runs with different auto-scaled counts. They include
+        // the benchmark's setup code, same as the timing does.
+        const double div = static_cast<double>(iters);
+        result.metrics.emplace_back("allocs_per_iter",
+                                    static_cast<double>(allocs) / div);
+        for (const auto& [cname, count] : counters.values())
+          result.metrics.emplace_back(cname + "_per_iter",
+                                      static_cast<double>(count) / div);
+        break;
+      }
+      const double target = min_time * 1.4;
+      std::uint64_t next =
+          elapsed > 0 ? static_cast<std::uint64_t>(
+                            static_cast<double>(iters) * target / elapsed)
+                      : iters * 2;
+      iters = next > iters ? next : iters * 2;
+    }
+    std::printf("%-40s %12llu iters %12.1f ns/iter", result.name.c_str(),
+                static_cast<unsigned long long>(result.iterations),
+                result.ns_per_iter);
+    if (result.bytes_per_sec != 0)
+      std::printf(" %9.1f MB/s", result.bytes_per_sec / 1e6);
+    for (const auto& [name, value] : result.metrics)
+      std::printf("  %s=%.3f", name.c_str(), value);
+    std::printf("\n");
+    results.push_back(std::move(result));
+  }
+
+  if (json_path != nullptr) emit_json(results, json_path);
+  return 0;
+}
+
+}  // namespace exynos::bench
@@ -0,0 +1,83 @@
+#pragma once
+
+// In-tree micro-benchmark harness.
+//
+// Shaped like Google Benchmark's API (range-for over State, auto-scaled
+// iteration counts, bytes/sec reporting) but self-contained: this repo
+// builds on devices and build farms with no external package access.
+// Results print as a table and optionally as JSON (--json=FILE) so runs
+// can be diffed across commits; extra named metrics attach to each result
+// for the regression gates built on top of this.
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace exynos::bench {
+
+class State {
+ public:
+  explicit State(std::uint64_t iters) : iters_(iters) {}
+
+  // Non-trivial destructor keeps `for (auto _ : state)` loop variables
+  // from tripping -Wunused-variable.
+  struct Tick {
+    Tick() {}
+    ~Tick() {}
+  };
+  struct iterator {
+    std::uint64_t n;
+    bool operator!=(const iterator& o) const { return n != o.n; }
+    void operator++() { ++n; }
+    Tick operator*() const { return {}; }
+  };
+  iterator begin() { return {0}; }
+  iterator end() { return {iters_}; }
+
+  std::uint64_t iterations() const { return iters_; }
+
+  // Bytes consumed by one iteration; reported as MB/s.
+  void set_bytes_per_iter(std::uint64_t bytes) { bytes_per_iter_ = bytes; }
+  // Free-form metric attached to the result (and the JSON output).
+  void set_metric(const std::string& name, double value) {
+    metrics_.push_back({name, value});
+  }
+
+  std::uint64_t bytes_per_iter() const { return bytes_per_iter_; }
+  const std::vector<std::pair<std::string, double>>& metrics() const {
+    return metrics_;
+  }
+
+ private:
+  std::uint64_t iters_;
+  std::uint64_t bytes_per_iter_ = 0;
+  std::vector<std::pair<std::string, double>> metrics_;
+};
+
+using BenchFn = void (*)(State&);
+
+struct Result {
+  std::string name;
+  std::uint64_t iterations = 0;
+  double ns_per_iter = 0;
+  double bytes_per_sec = 0;
+  std::vector<std::pair<std::string, double>> metrics;
+};
+
+void register_benchmark(const char* name, BenchFn fn);
+
+// Runs every registered benchmark. Flags: --json=FILE, --min-time=SECONDS
+// (default 0.2), --filter=SUBSTRING.
+int run_benchmarks(int argc, char** argv);
+
+}  // namespace exynos::bench
+
+#define EXYNOS_BENCHMARK(fn)                            \
+  static const int exybench_reg_##fn =                  \
+      (::exynos::bench::register_benchmark(#fn, fn), 0)
+
+#define EXYNOS_BENCHMARK_MAIN()                                   \
+  int main(int argc, char** argv) {                               \
+    return ::exynos::bench::run_benchmarks(argc, argv);           \
+  }
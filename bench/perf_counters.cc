@@ -0,0 +1,70 @@
+#include "perf_counters.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace exynos::bench {
+
+namespace {
+
+long perf_event_open(perf_event_attr* attr, pid_t pid, int cpu, int group_fd,
+                     unsigned long flags) {
+  return ::syscall(SYS_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+constexpr std::uint64_t hw_cache(std::uint64_t cache, std::uint64_t op,
+                                 std::uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  open("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  open("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  open("cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  open("llc_misses", PERF_TYPE_HW_CACHE,
+       hw_cache(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                PERF_COUNT_HW_CACHE_RESULT_MISS));
+}
+
+PerfCounters::~PerfCounters() {
+  for (const auto& [name, fd] : fds_) ::close(fd);
+}
+
+void PerfCounters::open(const char* name, std::uint32_t type,
+                        std::uint64_t config) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  const long fd = perf_event_open(&attr, 0, -1, -1, 0);
+  if (fd >= 0) fds_.emplace_back(name, static_cast<int>(fd));
+}
+
+void PerfCounters::start() {
+  for (const auto& [name, fd] : fds_) {
+    ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+void PerfCounters::stop() {
+  values_.clear();
+  for (const auto& [name, fd] : fds_) {
+    ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    std::uint64_t count = 0;
+    if (::read(fd, &count, sizeof(count)) == sizeof(count))
+      values_.emplace_back(name, count);
+  }
+}
+
+}  // namespace exynos::bench
@@ -0,0 +1,53 @@
+#pragma once
+
+// Hardware counters and allocation counts for the benchmark harness.
+//
+// PerfCounters wraps perf_event_open for the metrics the regression gate
+// tracks: cycles, instructions and cache misses (the generic and the
+// last-level-cache events — raw L2/L3 event codes differ per Exynos SoC,
+// so the portable LLC events stand in for them). Counters the kernel
+// refuses (paranoid level, seccomp, missing PMU) are silently skipped,
+// mirroring how UringWriter degrades without io_uring: the harness still
+// runs and simply reports fewer columns.
+//
+// allocation_count() is backed by the operator new hook in
+// alloc_hook.cc, linked into every bench binary; the harness diffs it
+// around a run to report allocations per iteration, which is what turns
+// "the arena path does not allocate" from a claim into a gate.
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace exynos::bench {
+
+// Heap allocations (operator new calls) since process start.
+std::uint64_t allocation_count();
+
+class PerfCounters {
+ public:
+  // Opens every counter the kernel allows; see above for the set.
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  void start();  // resets and enables
+  void stop();   // disables and reads into values()
+
+  // One {name, count} per counter that opened, filled by stop().
+  const std::vector<std::pair<std::string, std::uint64_t>>& values() const {
+    return values_;
+  }
+  bool any() const { return !fds_.empty(); }
+
+ private:
+  void open(const char* name, std::uint32_t type, std::uint64_t config);
+
+  std::vector<std::pair<std::string, int>> fds_;
+  std::vector<std::pair<std::string, std::uint64_t>> values_;
+};
+
+}  // namespace exynos::bench
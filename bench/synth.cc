@@ -0,0 +1,48 @@
+#include "synth.h"
+
+namespace exynos::bench {
+
+namespace {
+
+// splitmix64: tiny, seedable, stable across platforms.
+std::uint64_t next(std::uint64_t& state) {
+  std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace
+
+std::string Synth::generate(const SynthOptions& opts) {
+  std::uint64_t rng = opts.seed;
+  std::string out;
+  out.reserve(opts.records * (96 + opts.payload_bytes + opts.extra_fields * 12));
+  std::string payload(opts.payload_bytes, 'p');
+  for (std::uint64_t i = 0; i < opts.records; ++i) {
+    const std::uint64_t r = next(rng);
+    out += "{\"id\":\"req-";
+    out += std::to_string(i);
+    out += "\",\"endpoint\":\"/api/ep-";
+    out += std::to_string(r % opts.endpoints);
+    out += "\",\"latency_ms\":";
+    out += std::to_string(r % 1000);
+    out += ",\"ts\":";
+    out += std::to_string(1700000000000ULL + i * 13);
+    for (std::uint32_t x = 0; x < opts.extra_fields; ++x) {
+      out += ",\"x";
+      out += std::to_string(x);
+      out += "\":";
+      out += std::to_string((r >> (x % 32)) % 100000);
+    }
+    if (opts.payload_bytes != 0) {
+      out += ",\"payload\":\"";
+      out += payload;
+      out += "\"";
+    }
+    out += "}\n";
+  }
+  return out;
+}
+
+}  // namespace exynos::bench
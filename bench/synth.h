@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace exynos::bench {
+
+// Deterministic synthetic requests.jsonl generator.
+//
+// Same options + seed always produce byte-identical output, so results
+// are comparable across commits and machines. The field mix mirrors the
+// production schema: string id, dictionary-friendly endpoint, integer
+// latency and timestamp, plus optional padding and extra fields to dial
+// record size and parse cost.
+struct SynthOptions {
+  std::uint64_t records = 10000;
+  std::uint32_t endpoints = 50;      // dictionary cardinality
+  std::uint32_t extra_fields = 0;    // int fields x0..xN
+  std::uint32_t payload_bytes = 0;   // opaque string padding per record
+  std::uint64_t seed = 1;
+};
+
+class Synth {
+ public:
+  static std::string generate(const SynthOptions& opts);
+};
+
+}  // namespace exynos::bench
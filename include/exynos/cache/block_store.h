@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exynos/jsonl/mmap_reader.h"
+
+namespace exynos::cache {
+
+class ColumnStore;
+
+// Compressed cold tier (`requests.exyblk`) derived from a sidecar.
+//
+// A year of full-resolution .exycol does not fit on device flash, so cold
+// generations are re-tiered: each column is cut into blocks of ~64K rows,
+// every block chunk is compressed independently (zstd when the build has
+// it, raw otherwise) and carries min/max zone-map metadata, and the query
+// path consults the zone maps before paying for decompression — selective
+// scans never touch most blocks. String chunks are self-contained
+// (per-block dictionary travels with the codes), so a block decompresses
+// and evaluates without any other part of the file.
+
+enum class BlockCodec : std::uint32_t { None = 0, Zstd = 1 };
+
+// Returns Zstd when the build was configured with zstd, None otherwise.
+BlockCodec preferred_codec();
+
+// On-disk structures, same conventions as the .exycol header: little
+// endian, naturally aligned, 64-bit fleet only.
+struct BlockFileHeader {
+  static constexpr std::uint64_t kMagic = 0x31304B4C42595845ULL;  // "EXYBLK01"
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t column_count;
+  std::uint64_t block_count;
+  std::uint64_t row_count;
+  std::uint32_t codec;       // BlockCodec
+  std::uint32_t block_rows;  // rows per block (last block may be short)
+  std::uint64_t reserved[3];
+};
+
+struct BlockColumnInfo {
+  char name[48];     // NUL-padded JSON key
+  std::uint8_t type;  // cache::ColumnType
+  std::uint8_t pad[7];
+};
+
+// One compressed chunk: column `c` of block `b`, at directory index
+// b * column_count + c. comp_len == raw_len means the chunk is stored
+// uncompressed (incompressible data, or codec None).
+struct ChunkDesc {
+  std::uint64_t off;
+  std::uint64_t comp_len;
+  std::uint64_t raw_len;
+  // Zone map over valid rows; Int64/Bool only. A chunk with no valid
+  // rows stores min > max so every predicate skips it.
+  std::int64_t min;
+  std::int64_t max;
+};
+
+static_assert(sizeof(BlockFileHeader) == 64, "header must stay one line");
+
+// Raw (decompressed) chunk layout by column type:
+//   Int64:  i64[rows]                      + validity bitmap
+//   Double: f64[rows]                      + validity bitmap
+//   Bool:   u8[rows]                       + validity bitmap
+//   String: u32 codes[rows], zero-padded to 8 bytes, then u64 dict_n +
+//           u64 offsets[dict_n + 1] + dict bytes + validity bitmap
+// The validity bitmap is (rows + 7) / 8 bytes, 1 = value present.
+
+// Re-tiers an uncompressed sidecar into a block file. Throws
+// std::system_error on I/O failure.
+class BlockStoreWriter {
+ public:
+  struct Options {
+    std::uint32_t block_rows = 64 * 1024;
+    BlockCodec codec = preferred_codec();
+  };
+
+  static void write(const ColumnStore& source, const std::string& path) {
+    write(source, path, {});
+  }
+  static void write(const ColumnStore& source, const std::string& path,
+                    Options opts);
+};
+
+// mmap-backed reader. Directory and zone maps are usable straight from
+// the mapping; only chunk payloads ever need decompression.
+class BlockStore {
+ public:
+  // Throws std::system_error on I/O failure and std::runtime_error on a
+  // corrupt or wrong-magic file.
+  explicit BlockStore(const std::string& path);
+
+  std::uint64_t rows() const { return header_->row_count; }
+  std::uint64_t blocks() const { return header_->block_count; }
+  std::uint32_t columns() const { return header_->column_count; }
+  BlockCodec codec() const { return static_cast<BlockCodec>(header_->codec); }
+
+  std::uint32_t block_row_count(std::uint64_t block) const;
+  std::uint64_t block_row_begin(std::uint64_t block) const {
+    return block * header_->block_rows;
+  }
+
+  std::string_view column_name(std::uint32_t col) const;
+  std::uint8_t column_type(std::uint32_t col) const {
+    return columns_[col].type;
+  }
+  std::optional<std::uint32_t> find_column(std::string_view name) const;
+
+  const ChunkDesc& chunk(std::uint64_t block, std::uint32_t col) const {
+    return chunks_[block * header_->column_count + col];
+  }
+
+  // Decompresses chunk (block, col) into `scratch` and returns a view of
+  // the raw layout described above. Chunks stored uncompressed are
+  // returned directly from the mapping without copying.
+  std::string_view read_chunk(std::uint64_t block, std::uint32_t col,
+                              std::vector<char>& scratch) const;
+
+ private:
+  jsonl::MmapReader map_;
+  const BlockFileHeader* header_;
+  const BlockColumnInfo* columns_;
+  const ChunkDesc* chunks_;
+};
+
+}  // namespace exynos::cache
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exynos/index/id_map.h"
+#include "exynos/jsonl/mmap_reader.h"
+#include "exynos/jsonl/parser.h"
+#include "exynos/mem/huge_region.h"
+#include "exynos/mem/string_pool.h"
+
+namespace exynos::cache {
+
+// Columnar sidecar cache (`requests.exycol`) for requests.jsonl.
+//
+// The file is laid out so a loader needs zero deserialization: a fixed
+// header, a column directory, then 64-byte-aligned column payloads that are
+// usable directly from the mapping. String columns are dictionary-encoded
+// (u32 code per row + offset table + byte blob). The header records the
+// source file's size and mtime; a mismatch means the cache is stale and
+// must be rebuilt.
+
+enum class ColumnType : std::uint8_t { Int64, Double, Bool, String };
+
+// On-disk structures. Everything is little-endian and naturally aligned;
+// the fleet and this format are 64-bit only.
+struct FileHeader {
+  static constexpr std::uint64_t kMagic = 0x31304C4F43595845ULL;  // "EXYCOL01"
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t column_count;
+  std::uint64_t row_count;
+  std::uint64_t source_size;
+  std::int64_t source_mtime_ns;
+  std::uint64_t index_off;  // embedded IdMap image, 0 when absent
+  std::uint64_t index_len;
+  std::uint64_t reserved;
+};
+
+struct ColumnDesc {
+  char name[48];                 // NUL-padded JSON key
+  std::uint8_t type;             // ColumnType
+  std::uint8_t pad[7];
+  std::uint64_t data_off;        // row-width payload (codes / values)
+  std::uint64_t data_len;
+  std::uint64_t dict_offsets_off;  // String only: u64[dict_size + 1]
+  std::uint64_t dict_offsets_len;
+  std::uint64_t dict_bytes_off;    // String only: concatenated entries
+  std::uint64_t dict_bytes_len;
+  std::uint64_t valid_off;       // validity bitmap, 1 bit per row, 1 = set
+  std::uint64_t valid_len;
+};
+
+static_assert(sizeof(FileHeader) == 64, "header must stay one cache line");
+
+// Accumulates parsed records and writes the sidecar in one pass.
+//
+// A field's type is fixed by its first non-null occurrence; later values of
+// a different type are recorded as null (our schemas are stable, this only
+// guards against stray producer bugs). Nested values are stored as their
+// raw JSON text in a string column.
+class ColumnStoreBuilder {
+ public:
+  void add(const jsonl::Record& record) {
+    add(jsonl::RecordView{record.fields.data(),
+                          static_cast<std::uint32_t>(record.fields.size())});
+  }
+  void add(jsonl::RecordView record);
+  std::uint64_t rows() const { return rows_; }
+
+  // Embeds the id -> file-offset index in the written sidecar so lookups
+  // never rescan the log.
+  void set_id_index(const index::IdMap& map) { index_image_ = map.serialize(); }
+
+  // Writes the sidecar; `source_size`/`source_mtime_ns` identify the
+  // requests.jsonl generation this cache was built from. Throws
+  // std::system_error on I/O failure.
+  void write(const std::string& path, std::uint64_t source_size,
+             std::int64_t source_mtime_ns) const;
+
+ private:
+  struct ColumnBuild {
+    std::string name;
+    ColumnType type;
+    std::vector<std::int64_t> ints;
+    std::vector<double> doubles;
+    std::vector<std::uint8_t> bools;
+    std::vector<std::uint32_t> codes;
+    // Interning pool doubling as the dictionary: pool ids are dense in
+    // first-intern order, which is exactly the code space the file wants.
+    // Shared so the snapshot write() takes of columns_ stays cheap.
+    std::shared_ptr<mem::StringPool> dict;
+    std::vector<std::uint8_t> valid;  // bitmap, 1 = value present
+    std::uint64_t filled = 0;         // rows appended so far
+
+    void pad_to(std::uint64_t row);
+    void mark_valid(std::uint64_t row);
+  };
+
+  ColumnBuild& column(std::string_view name, ColumnType type);
+
+  std::vector<ColumnBuild> columns_;
+  std::vector<std::uint8_t> index_image_;
+  std::uint64_t rows_ = 0;
+};
+
+// mmap-backed zero-deserialization view over a written sidecar.
+class ColumnStore {
+ public:
+  // Throws std::system_error on I/O failure and std::runtime_error on a
+  // corrupt or wrong-magic file.
+  explicit ColumnStore(const std::string& path);
+
+  // True when `path` exists and matches the given source generation.
+  static bool up_to_date(const std::string& path, std::uint64_t source_size,
+                         std::int64_t source_mtime_ns);
+
+  std::uint64_t rows() const { return header_->row_count; }
+  std::uint32_t columns() const { return header_->column_count; }
+
+  class Column {
+   public:
+    Column(const ColumnDesc* desc, const char* base)
+        : desc_(desc), base_(base) {}
+
+    std::string_view name() const;
+    ColumnType type() const { return static_cast<ColumnType>(desc_->type); }
+
+    const std::int64_t* ints() const;
+    const double* doubles() const;
+    const std::uint8_t* bools() const;
+    const std::uint32_t* codes() const;
+
+    std::uint64_t dict_size() const;
+    std::string_view dict_entry(std::uint32_t code) const;
+    // Convenience row accessor for string columns.
+    std::string_view str(std::uint64_t row) const;
+
+    bool is_valid(std::uint64_t row) const {
+      return (valid_bits()[row >> 3] >> (row & 7)) & 1;
+    }
+    // Raw validity bitmap (1 bit per row) for bulk consumers like
+    // index::TimeIndex.
+    const std::uint8_t* valid_bits() const {
+      return reinterpret_cast<const std::uint8_t*>(base_ + desc_->valid_off);
+    }
+
+   private:
+    const ColumnDesc* desc_;
+    const char* base_;
+  };
+
+  // Returns the column named `name`, or nullopt.
+  std::optional<Column> find(std::string_view name) const;
+  Column at(std::uint32_t idx) const;
+
+  // Zero-copy view of the embedded id index, or nullopt when the sidecar
+  // was written without one.
+  std::optional<index::IdMap> id_index() const;
+
+  // Size of the embedded id index image, 0 when absent. Sizes the region
+  // for id_index_pinned().
+  std::uint64_t id_index_bytes() const {
+    return header_->index_off != 0 ? header_->index_len : 0;
+  }
+
+  // Copies the id index image into `region` (>= id_index_bytes()) and
+  // returns a view over that copy, so random probes hit huge pages
+  // instead of the 4K file mapping. nullopt when the sidecar has no
+  // index; throws std::invalid_argument when the region is too small.
+  std::optional<index::IdMap> id_index_pinned(mem::HugeRegion& region) const;
+
+ private:
+  jsonl::MmapReader map_;
+  const FileHeader* header_;
+  const ColumnDesc* dir_;
+};
+
+// Loads the sidecar next to `jsonl_path` (building or rebuilding it first
+// when missing or stale). This is the standard cold-start entry point.
+ColumnStore open_or_build(const std::string& jsonl_path,
+                          const std::string& cache_path);
+
+}  // namespace exynos::cache
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace exynos::index {
+
+// Open-addressing hash index from request id to file offset.
+//
+// Swiss-table layout: one control byte per slot (high bit set = empty,
+// low 7 bits = second-level hash when full), probed a group of 16 at a
+// time with SIMD byte compares — NEON on the fleet, SWAR elsewhere. Slots
+// store the full 64-bit id hash plus the record's byte offset in
+// requests.jsonl; id equality is hash equality by design (the request-id
+// space is far below 2^64).
+//
+// The table serializes to a flat blob embedded in the .exycol sidecar and
+// reattaches as a zero-copy read-only view over the mapping.
+class IdMap {
+ public:
+  static constexpr std::uint64_t kMagic = 0x58444958594D4150ULL;  // "XDIXYMAP"
+
+  IdMap() = default;
+
+  static std::uint64_t hash(std::string_view id);
+
+  // Owned (building) mode only.
+  void reserve(std::uint64_t ids);
+  void insert(std::string_view id, std::uint64_t offset) {
+    insert_hash(hash(id), offset);
+  }
+  void insert_hash(std::uint64_t h, std::uint64_t offset);
+
+  // Either mode.
+  std::optional<std::uint64_t> find(std::string_view id) const {
+    return find_hash(hash(id));
+  }
+  std::optional<std::uint64_t> find_hash(std::uint64_t h) const;
+
+  // Batched point lookups for the serving path's join-against-history
+  // bursts. Probes are software-pipelined: the control and slot groups
+  // for probe i+K are prefetched while probe i resolves, hiding the DRAM
+  // stall a cold random probe otherwise eats. `offsets[i]` receives the
+  // offset for `ids[i]`, or kNotFound. Spans must be the same length
+  // (throws std::invalid_argument otherwise).
+  static constexpr std::uint64_t kNotFound = ~std::uint64_t{0};
+  void lookup_batch(std::span<const std::string_view> ids,
+                    std::span<std::uint64_t> offsets) const;
+  void lookup_batch_hash(std::span<const std::uint64_t> hashes,
+                         std::span<std::uint64_t> offsets) const;
+
+  std::uint64_t size() const { return size_; }
+  std::uint64_t capacity() const { return capacity_; }
+  bool is_view() const { return view_; }
+
+  // Flat persistent image (header + control bytes + slots), 64-byte
+  // aligned internally so it can be dropped at an aligned file offset.
+  std::vector<std::uint8_t> serialize() const;
+  // Zero-copy attach to a serialized image; the memory must outlive the
+  // returned map. Throws std::runtime_error on a corrupt image.
+  static IdMap view(const void* data, std::size_t len);
+
+  struct Slot {
+    std::uint64_t hash;
+    std::uint64_t offset;
+  };
+
+ private:
+  void grow();
+  void insert_no_grow(std::uint64_t h, std::uint64_t offset);
+
+  // Owned storage (empty in view mode).
+  std::vector<std::uint8_t> ctrl_store_;
+  std::vector<Slot> slot_store_;
+  // Active table (points into the stores or into a mapped image).
+  const std::uint8_t* ctrl_ = nullptr;
+  const Slot* slots_ = nullptr;
+  std::uint64_t capacity_ = 0;  // multiple of 16
+  std::uint64_t size_ = 0;
+  bool view_ = false;
+};
+
+}  // namespace exynos::index
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace exynos::index {
+
+// Half-open row range [begin, end).
+struct RowRange {
+  std::uint64_t begin = 0;
+  std::uint64_t end = 0;
+};
+
+// Sorted timestamp -> row-range index for time-range pruning.
+//
+// Ingest appends in arrival order, so timestamps are (nearly) sorted by
+// row. The index summarizes fixed-size row buckets with their min/max
+// timestamp; a window query binary-searches the bucket bounds and
+// returns the coalesced row ranges that can possibly intersect the
+// window, so scans touch O(rows in window) instead of the whole table.
+// If the data turns out not to be time-ordered the index degrades to a
+// linear bucket walk over the same min/max summaries — still a zone-map
+// prune, just without the binary search.
+//
+// Null timestamps are excluded from the bucket bounds; rows with a null
+// timestamp can never satisfy a time predicate, matching the engine's
+// validity-ANDing filter semantics.
+class TimeIndex {
+ public:
+  static constexpr std::uint64_t kDefaultBucketRows = 1024;
+
+  TimeIndex() = default;
+  // `valid` is the column's validity bitmap (1 bit per row, 1 = present);
+  // nullptr means every row carries a timestamp.
+  TimeIndex(const std::int64_t* ts, const std::uint8_t* valid,
+            std::uint64_t rows, std::uint64_t bucket_rows = kDefaultBucketRows);
+
+  // Row ranges possibly holding timestamps in [lo, hi] (inclusive), in
+  // row order with adjacent buckets coalesced.
+  std::vector<RowRange> query(std::int64_t lo, std::int64_t hi) const;
+
+  bool empty() const { return buckets_.empty(); }
+  // Bounds over every indexed (non-null) timestamp; callers prune whole
+  // segments with these before looking at buckets.
+  std::int64_t min_ts() const { return min_ts_; }
+  std::int64_t max_ts() const { return max_ts_; }
+  bool sorted() const { return sorted_; }
+
+ private:
+  struct Bucket {
+    std::int64_t min = 0;
+    std::int64_t max = 0;
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+  };
+
+  std::vector<Bucket> buckets_;
+  std::int64_t min_ts_ = 0;
+  std::int64_t max_ts_ = 0;
+  bool sorted_ = true;  // bucket bounds nondecreasing: binary search ok
+};
+
+}  // namespace exynos::index
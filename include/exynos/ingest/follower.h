@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace exynos::ingest {
+
+// tail -f for requests.jsonl.
+//
+// Watches the file with inotify, remaps the grown tail on each
+// modification, and invokes the callback once per newly completed record.
+// A torn final line (producer mid-append) is never emitted; it is picked
+// up once its newline arrives. Rotation (the path now naming a different
+// inode) drains the old file and transparently reopens the new one.
+//
+// Record views point into a transient mapping of the tail and are only
+// valid for the duration of the callback — downstream stages must parse or
+// copy before returning (the pipeline's per-chunk arenas do exactly that).
+class Follower {
+ public:
+  // `offset` is the record's byte offset in the current file generation.
+  using Callback =
+      std::function<void(std::string_view record, std::uint64_t offset)>;
+
+  Follower(std::string path, Callback on_record);
+  ~Follower();
+
+  Follower(const Follower&) = delete;
+  Follower& operator=(const Follower&) = delete;
+
+  // Spawns the watch thread. Throws std::system_error if the file cannot
+  // be opened or the inotify watch cannot be established.
+  void start();
+  // Stops and joins the watch thread; drains nothing further.
+  void stop();
+
+  // Synchronously processes any growth (and rotation) since the last
+  // call. Exposed for deterministic use in tests and single-threaded
+  // callers; the watch thread is a poll loop around this.
+  void poll_once();
+
+  std::uint64_t processed_bytes() const {
+    return processed_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void open_source();
+  void drain_growth();
+  bool rotated() const;
+  void run();
+
+  std::string path_;
+  Callback on_record_;
+  int fd_ = -1;
+  int inotify_fd_ = -1;
+  int wakeup_pipe_[2] = {-1, -1};
+  std::uint64_t ino_ = 0;
+  std::atomic<std::uint64_t> processed_{0};  // bytes fully consumed
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+};
+
+}  // namespace exynos::ingest
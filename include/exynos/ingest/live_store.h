@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/index/id_map.h"
+#include "exynos/index/time_index.h"
+#include "exynos/jsonl/parser.h"
+#include "exynos/mem/arena.h"
+#include "exynos/query/engine.h"
+#include "exynos/sched/steal_pool.h"
+#include "exynos/wal/journal.h"
+
+namespace exynos::ingest {
+
+// Incrementally maintained view over a mmapped base plus live appends.
+//
+// Records tailed in by the Follower land in a small in-memory delta (an
+// owned IdMap plus arena-backed rows). Lookups union delta over sealed
+// segments over the base, newest first, so a fresh append is visible
+// without touching the 100M-row base index. When the delta passes the
+// compaction threshold it is sealed into a delta-sized .exycol segment
+// file, so compaction cost is proportional to the delta, never to the
+// base; a full rebuild from the source log is left for maintenance
+// windows, not the steady state.
+class LiveStore {
+ public:
+  struct Options {
+    std::string jsonl_path;
+    std::string cache_path;
+    // In-memory delta rows that trigger seal-to-segment compaction.
+    std::uint64_t compact_threshold = 100000;
+    // When set, threshold compaction runs as a background pool task
+    // instead of synchronously inside append().
+    sched::StealPool* pool = nullptr;
+    // Int64 column carrying event time. Base and sealed segments each get
+    // a TimeIndex over it, so window queries prune to the rows (and skip
+    // the segments) actually inside the window. Empty disables indexing.
+    std::string time_column = "ts";
+    // Write-ahead journal covering the in-memory delta: appends are
+    // group-committed there and replayed at startup, so a reboot
+    // mid-compaction loses nothing. Empty disables journaling.
+    std::string wal_path;
+  };
+
+  explicit LiveStore(Options opts);
+
+  // Follower-callback shaped: copies the record into the delta. The view
+  // only needs to live for the duration of the call. A failed background
+  // compaction (ENOSPC and kin) is latched and rethrown here or from
+  // compact(), whichever runs first; the sealed rows stay queryable and
+  // the next threshold crossing retries the write.
+  void append(std::string_view record, std::uint64_t offset);
+
+  // Point lookup: delta, then sealed segments (newest first), then base.
+  std::optional<std::uint64_t> find(std::string_view id) const;
+
+  // Runs `query` over base + sealed segments + delta and merges the
+  // partial results (sum for count/sum, min/max for min/max).
+  query::Result run(const query::Query& query) const;
+
+  // Seals the in-memory delta into a new segment file now. No-op when
+  // the delta is empty.
+  void compact();
+
+  std::uint64_t base_rows() const;
+  std::uint64_t delta_rows() const;
+  std::size_t segment_count() const;
+
+ private:
+  struct DeltaRecord {
+    std::string_view raw;  // the arena copy of the source line
+    jsonl::RecordView view;
+    std::uint64_t offset;
+  };
+
+  // Delta state swapped out under the lock so the segment build can run
+  // without it. While a seal is in flight the records stay queryable
+  // through `sealing_`.
+  struct SealedDelta {
+    mem::Arena arena;
+    std::vector<DeltaRecord> records;
+    index::IdMap ids;
+    std::size_t segment = 0;
+  };
+
+  void append_locked(std::string_view record, std::uint64_t offset);
+  void compact_locked();
+  void rethrow_compact_error_locked();
+  SealedDelta* seal_delta_locked();
+  void build_segment(const SealedDelta& sealed, const std::string& path) const;
+  void install_segment_locked(const std::string& path);
+  std::string segment_path(std::size_t n) const;
+
+  Options opts_;
+  cache::ColumnStore base_;
+  std::unique_ptr<index::TimeIndex> base_tindex_;
+
+  mutable std::mutex mu_;
+  mem::Arena delta_arena_;
+  std::vector<DeltaRecord> delta_;
+  index::IdMap delta_ids_;
+  std::unique_ptr<SealedDelta> sealing_;  // non-null while a seal builds
+  std::exception_ptr compact_error_;  // first unreported compaction failure
+  std::vector<std::unique_ptr<cache::ColumnStore>> segments_;
+  std::vector<std::unique_ptr<index::TimeIndex>> segment_tindex_;
+  std::unique_ptr<wal::Journal> journal_;
+  std::size_t next_segment_ = 0;
+  bool compact_scheduled_ = false;
+};
+
+}  // namespace exynos::ingest
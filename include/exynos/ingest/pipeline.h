@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "exynos/jsonl/parser.h"
+#include "exynos/mem/arena.h"
+
+namespace exynos::ingest {
+
+// One record-aligned slice of the mapped file after parsing. All field
+// storage lives in the chunk's arena and is freed wholesale when the
+// chunk is destroyed — no per-record heap traffic.
+struct ParsedChunk {
+  std::size_t index = 0;           // position in file order
+  std::size_t begin_offset = 0;    // byte offset of the chunk in the file
+  mem::Arena arena;
+  std::vector<jsonl::RecordView> records;
+  std::size_t malformed = 0;       // bad lines skipped, for ingest stats
+};
+
+struct PipelineOptions {
+  // 0 means one worker per online core (minus the merge thread).
+  unsigned workers = 0;
+  std::size_t chunk_bytes = std::size_t{4} << 20;
+  // big.LITTLE-aware placement: parse workers go to the efficiency
+  // (Cortex-A) cores, the merge stage stays on the performance (Cortex-X)
+  // cores. On homogeneous machines this degrades to no pinning.
+  bool pin_cores = true;
+  // Stripe contiguous chunk runs over DSU clusters so each chunk's parse
+  // and arena writes stay behind one L3 slice; only the ordered merge
+  // crosses clusters. Moot on single-cluster machines.
+  bool cluster_local = true;
+};
+
+// Parallel sharded ingestion over a mapped requests.jsonl.
+//
+// The file is split into chunks advanced to the next record boundary, a
+// worker pool parses chunks independently, and the consumer callback runs
+// on the calling thread strictly in file order — downstream index and
+// column builders rely on that ordering.
+class Pipeline {
+ public:
+  using Consumer = std::function<void(ParsedChunk&&)>;
+
+  explicit Pipeline(PipelineOptions opts = {});
+
+  // Blocks until every chunk of `data` has been parsed and consumed.
+  void run(std::string_view data, const Consumer& consume);
+
+  // Record-aligned chunk boundaries (exposed for tests and for callers
+  // that shard work themselves).
+  static std::vector<std::string_view> split_chunks(std::string_view data,
+                                                    std::size_t chunk_bytes);
+
+ private:
+  PipelineOptions opts_;
+};
+
+}  // namespace exynos::ingest
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace exynos::io {
+
+// Asynchronous positional file writer backed by io_uring.
+//
+// write_at() copies the payload into one of `queue_depth` registered
+// buffers and queues an IORING_OP_WRITE_FIXED, so sidecar persistence and
+// delta compaction overlap with ongoing parsing instead of stalling on
+// write(2). When no buffer is free the caller blocks reaping completions,
+// which bounds memory at queue_depth * buffer_bytes. Errors from queued
+// writes surface at the next flush()/close().
+//
+// On kernels without io_uring (or where seccomp denies it) construction
+// silently degrades to synchronous pwrite; using_uring() reports which
+// path is live.
+class UringWriter {
+ public:
+  struct Options {
+    unsigned queue_depth = 32;
+    std::size_t buffer_bytes = 256 * 1024;
+  };
+
+  // Creates (O_CREAT | O_TRUNC) `path` for writing. Throws
+  // std::system_error when the file cannot be opened.
+  explicit UringWriter(const std::string& path) : UringWriter(path, {}) {}
+  UringWriter(const std::string& path, Options opts);
+  ~UringWriter();
+
+  UringWriter(const UringWriter&) = delete;
+  UringWriter& operator=(const UringWriter&) = delete;
+
+  // Queues `len` bytes at absolute file offset `offset`. The caller's
+  // buffer only needs to live for the duration of the call. Writes larger
+  // than one registered buffer are split internally.
+  void write_at(std::uint64_t offset, const void* data, std::size_t len);
+
+  // Blocks until every queued write has completed, then rethrows the
+  // first deferred write error, if any.
+  void flush();
+
+  // flush() plus close(2). Idempotent; the destructor calls it
+  // best-effort without throwing.
+  void close();
+
+  bool using_uring() const { return ring_fd_ >= 0; }
+  std::uint64_t bytes_written() const { return bytes_written_; }
+
+ private:
+  struct Ring;  // mmapped queue state, defined in the .cc
+
+  void setup_ring(unsigned depth, std::size_t buffer_bytes);
+  void teardown_ring();
+  void submit(unsigned buf_index, std::uint64_t offset, std::size_t len);
+  // Consumes completions; waits for at least one when `wait` is set.
+  void reap(bool wait);
+
+  std::string path_;
+  int fd_ = -1;
+  int ring_fd_ = -1;
+  Ring* ring_ = nullptr;
+  std::size_t buffer_bytes_ = 0;
+  std::vector<unsigned> free_bufs_;
+  // Bytes submitted per buffer slot, to catch short completions.
+  std::vector<std::size_t> submitted_len_;
+  unsigned inflight_ = 0;
+  int deferred_errno_ = 0;
+  std::uint64_t bytes_written_ = 0;
+};
+
+}  // namespace exynos::io
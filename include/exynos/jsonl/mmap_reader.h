@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace exynos::jsonl {
+
+// Zero-copy reader for newline-delimited JSON files.
+//
+// The whole file is mapped read-only with mmap(2) and advised
+// MADV_SEQUENTIAL so the kernel prefetches ahead of the scan. Records are
+// handed out as std::string_view slices of the mapping — nothing is copied
+// and nothing is allocated per record. Views stay valid for the lifetime of
+// the reader.
+//
+// This is the canonical I/O path for requests.jsonl; every downstream stage
+// (scanner, parser, pipeline) consumes the mapping through this class.
+class MmapReader {
+ public:
+  // Maps `path` read-only. Throws std::system_error if the file cannot be
+  // opened, stat'ed or mapped.
+  explicit MmapReader(const std::string& path);
+  ~MmapReader();
+
+  MmapReader(MmapReader&& other) noexcept;
+  MmapReader& operator=(MmapReader&& other) noexcept;
+  MmapReader(const MmapReader&) = delete;
+  MmapReader& operator=(const MmapReader&) = delete;
+
+  // The entire mapped file.
+  std::string_view data() const { return {data_, size_}; }
+  std::size_t size() const { return size_; }
+
+  // Source-file identity captured at map time; used by cache layers to
+  // detect a changed requests.jsonl.
+  std::int64_t source_mtime_ns() const { return mtime_ns_; }
+  std::uint64_t source_size() const { return size_; }
+
+  // Forward iterator over records (lines). The trailing newline is not part
+  // of the record; a final line without a trailing newline is still yielded.
+  // Empty lines are skipped.
+  class Iterator {
+   public:
+    using value_type = std::string_view;
+
+    Iterator(const char* pos, const char* end) : pos_(pos), end_(end) {
+      advance();
+    }
+
+    std::string_view operator*() const { return record_; }
+    Iterator& operator++() {
+      advance();
+      return *this;
+    }
+    bool operator==(const Iterator& other) const {
+      return pos_ == other.pos_ && record_.empty();
+    }
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+   private:
+    void advance();
+
+    const char* pos_;
+    const char* end_;
+    std::string_view record_;
+  };
+
+  Iterator begin() const { return Iterator(data_, data_ + size_); }
+  Iterator end() const { return Iterator(data_ + size_, data_ + size_); }
+
+ private:
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::int64_t mtime_ns_ = 0;
+};
+
+}  // namespace exynos::jsonl
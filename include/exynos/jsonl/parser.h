@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace exynos::jsonl {
+
+// Flat-object JSON record parser.
+//
+// requests.jsonl records are single-line JSON objects; the parser extracts
+// top-level key/value pairs without copying string data — string values are
+// string_views into the input (still escaped; bulk unescaping is a separate
+// scanner-layer concern). Nested objects and arrays are captured as raw
+// balanced slices so downstream stages can ignore or re-parse them.
+
+enum class ValueType : std::uint8_t { Null, Bool, Int, Double, String, Raw };
+
+struct Value {
+  ValueType type = ValueType::Null;
+  union {
+    bool b;
+    std::int64_t i;
+    double d;
+  };
+  std::string_view s;  // String: escaped contents; Raw: the full slice.
+
+  std::int64_t as_int() const { return type == ValueType::Int ? i : 0; }
+};
+
+struct Field {
+  std::string_view key;
+  Value value;
+};
+
+struct Record {
+  std::vector<Field> fields;
+
+  // Returns the value for `key`, or nullptr. Records are small (a dozen
+  // fields); linear scan beats any hashing here.
+  const Value* find(std::string_view key) const {
+    for (const Field& f : fields)
+      if (f.key == key) return &f.value;
+    return nullptr;
+  }
+
+  void clear() { fields.clear(); }
+};
+
+// Non-owning view of a parsed record whose fields live in an arena (or
+// any storage outliving the view). This is what flows between pipeline
+// stages; `Record` stays as reusable parse scratch.
+struct RecordView {
+  const Field* fields = nullptr;
+  std::uint32_t count = 0;
+
+  const Value* find(std::string_view key) const {
+    for (std::uint32_t i = 0; i < count; ++i)
+      if (fields[i].key == key) return &fields[i].value;
+    return nullptr;
+  }
+};
+
+// Parses one record into `out` (cleared first). Returns false on malformed
+// input; the caller counts and skips bad lines rather than aborting a
+// multi-gigabyte load.
+bool parse_record(std::string_view json, Record& out);
+
+}  // namespace exynos::jsonl
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+#include <type_traits>
+
+namespace exynos::jsonl {
+
+// Compile-time schema-specialized parser.
+//
+// Most lines in a given feed match one of a handful of fixed shapes, and
+// the generic parse_record() pays for flexibility those lines never use:
+// a Field vector, a Value tag switch, and a key it has to keep around.
+// Schema<Fields...> bakes the expected keys in at compile time — each key's
+// hash is a constant folded into the match chain — and writes values
+// straight into a caller-defined packed struct. Anything surprising
+// (unknown key, wrong type, missing field) makes parse() return false so
+// the caller can fall back to the generic path:
+//
+//   struct Row { std::string_view id; std::int64_t latency_ms; };
+//   using ReqSchema = Schema<SchemaField<"id", &Row::id>,
+//                            SchemaField<"latency_ms", &Row::latency_ms>>;
+//   Row row;
+//   if (!ReqSchema::parse(line, row)) { /* parse_record(line, scratch) */ }
+//
+// Supported member types: std::int64_t, double, bool and
+// std::string_view (escaped contents between the quotes, same convention
+// as parse_record). Views point into the input line.
+
+// FNV-1a, evaluated at compile time for schema keys and inline while
+// scanning. Deliberately skips index/id_map.h's extra mixing: this hash
+// only needs to split a handful of known keys.
+constexpr std::uint64_t schema_key_hash(std::string_view s) {
+  std::uint64_t h = 1469598103934665603ull;
+  for (char ch : s) {
+    h ^= static_cast<unsigned char>(ch);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+// Structural string so a literal can be a template argument.
+template <std::size_t N>
+struct SchemaKey {
+  char chars[N] = {};
+  constexpr SchemaKey(const char (&s)[N]) {
+    for (std::size_t i = 0; i < N; ++i) chars[i] = s[i];
+  }
+  constexpr std::string_view view() const { return {chars, N - 1}; }
+};
+
+namespace schema_detail {
+
+template <auto Member>
+struct MemberTraits;
+
+template <typename C, typename T, T C::* Member>
+struct MemberTraits<Member> {
+  using Class = C;
+  using Type = T;
+};
+
+struct Cursor {
+  const char* p;
+  const char* end;
+
+  void skip_ws() {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+  }
+
+  bool consume(char c) {
+    if (p != end && *p == c) {
+      ++p;
+      return true;
+    }
+    return false;
+  }
+
+  // Opening quote already consumed; `out` gets the escaped contents.
+  bool scan_string(std::string_view& out) {
+    const char* start = p;
+    while (p != end) {
+      if (*p == '\\') {
+        p += 2 <= end - p ? 2 : 1;
+        continue;
+      }
+      if (*p == '"') {
+        out = {start, static_cast<std::size_t>(p - start)};
+        ++p;
+        return true;
+      }
+      ++p;
+    }
+    return false;
+  }
+
+  bool scan_int(std::int64_t& out) {
+    bool neg = consume('-');
+    if (p == end || *p < '0' || *p > '9') return false;
+    std::uint64_t v = 0;
+    while (p != end && *p >= '0' && *p <= '9')
+      v = v * 10 + static_cast<std::uint64_t>(*p++ - '0');
+    // A trailing '.', 'e' etc. means this is not the int the schema
+    // promised; let the generic parser sort it out.
+    if (p != end && (*p == '.' || *p == 'e' || *p == 'E')) return false;
+    out = neg ? -static_cast<std::int64_t>(v) : static_cast<std::int64_t>(v);
+    return true;
+  }
+
+  bool scan_double(double& out) {
+    const char* start = p;
+    while (p != end &&
+           (*p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E' ||
+            (*p >= '0' && *p <= '9')))
+      ++p;
+    char buf[32];
+    const auto len = static_cast<std::size_t>(p - start);
+    if (len == 0 || len >= sizeof(buf)) return false;
+    __builtin_memcpy(buf, start, len);
+    buf[len] = '\0';
+    out = std::strtod(buf, nullptr);
+    return true;
+  }
+
+  bool match_literal(std::string_view lit) {
+    if (static_cast<std::size_t>(end - p) < lit.size()) return false;
+    if (std::string_view(p, lit.size()) != lit) return false;
+    p += lit.size();
+    return true;
+  }
+};
+
+template <typename T>
+bool scan_into(Cursor& c, T& out) {
+  c.skip_ws();
+  if constexpr (std::is_same_v<T, std::string_view>) {
+    return c.consume('"') && c.scan_string(out);
+  } else if constexpr (std::is_same_v<T, std::int64_t>) {
+    return c.scan_int(out);
+  } else if constexpr (std::is_same_v<T, double>) {
+    return c.scan_double(out);
+  } else {
+    static_assert(std::is_same_v<T, bool>, "unsupported schema member type");
+    if (c.match_literal("true")) {
+      out = true;
+      return true;
+    }
+    if (c.match_literal("false")) {
+      out = false;
+      return true;
+    }
+    return false;
+  }
+}
+
+}  // namespace schema_detail
+
+template <SchemaKey Name, auto Member>
+struct SchemaField {
+  static constexpr std::string_view name() { return Name.view(); }
+  static constexpr std::uint64_t kHash = schema_key_hash(Name.view());
+  using Row = typename schema_detail::MemberTraits<Member>::Class;
+
+  static bool scan(schema_detail::Cursor& c, Row& row) {
+    return schema_detail::scan_into(c, row.*Member);
+  }
+};
+
+template <typename... Fields>
+struct Schema {
+  // All Fields must point into the same row type.
+  using Row = std::common_type_t<typename Fields::Row...>;
+  static constexpr std::size_t kFieldCount = sizeof...(Fields);
+
+  // Returns true and fills `row` iff `json` is a flat object containing
+  // exactly the schema's keys (in any order). On false, `row` is
+  // unspecified and the caller should use the generic parse_record().
+  static bool parse(std::string_view json, Row& row) {
+    schema_detail::Cursor c{json.data(), json.data() + json.size()};
+    c.skip_ws();
+    if (!c.consume('{')) return false;
+    c.skip_ws();
+    if (c.consume('}')) return kFieldCount == 0;
+    std::size_t matched = 0;
+    for (;;) {
+      c.skip_ws();
+      if (!c.consume('"')) return false;
+      std::string_view key;
+      if (!c.scan_string(key)) return false;
+      c.skip_ws();
+      if (!c.consume(':')) return false;
+      const std::uint64_t h = schema_key_hash(key);
+      // Constant-folded match chain: one compare per schema field, the
+      // hash test pruning almost every memcmp.
+      const bool ok =
+          ((h == Fields::kHash && key == Fields::name() && Fields::scan(c, row)
+                ? (++matched, true)
+                : false) ||
+           ...);
+      if (!ok) return false;
+      c.skip_ws();
+      if (c.consume(',')) continue;
+      if (c.consume('}')) break;
+      return false;
+    }
+    c.skip_ws();
+    return matched == kFieldCount && c.p == c.end;
+  }
+};
+
+}  // namespace exynos::jsonl
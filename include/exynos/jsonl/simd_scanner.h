@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "exynos/trace/trace.h"
+
+namespace exynos::jsonl {
+
+// Vectorized structural scan over JSONL bytes.
+//
+// The scanner works in 64-byte blocks and produces one bitmask per block:
+// bit i is set when byte i of the block equals the probed character. On the
+// Exynos fleet (all cores implement NEON) the byte compares run 16 lanes at
+// a time; elsewhere a SWAR fallback processes 8 bytes per step so even the
+// "scalar" path is not byte-at-a-time. The policy is chosen at compile time
+// via the template parameter — no runtime dispatch on the hot path.
+
+// Portable fallback: SWAR equality over 8-byte words.
+struct ScalarScanPolicy {
+  static std::uint64_t eq_mask64(const char* block, char c) {
+    std::uint64_t mask = 0;
+    const std::uint64_t splat = 0x0101010101010101ULL * static_cast<std::uint8_t>(c);
+    for (int w = 0; w < 8; ++w) {
+      std::uint64_t word;
+      std::memcpy(&word, block + w * 8, 8);
+      const std::uint64_t x = word ^ splat;
+      // Exact per-byte zero detector. The (x | 0x80..) form keeps every
+      // byte >= 0x80 before the subtract, so borrows never cross byte
+      // lanes (the naive `(x - 0x01..) & ~x & 0x80..` form does and gives
+      // false positives in adjacent lanes).
+      const std::uint64_t t =
+          ~(((x | 0x8080808080808080ULL) - 0x0101010101010101ULL) | x) &
+          0x8080808080808080ULL;
+      // Compress the eight high bits into an 8-bit mask.
+      const std::uint64_t m = ((t >> 7) * 0x0102040810204080ULL) >> 56;
+      mask |= m << (w * 8);
+    }
+    return mask;
+  }
+};
+
+#if defined(__ARM_NEON)
+// NEON policy: 16-lane compares, movemask via per-lane bit weights.
+struct NeonScanPolicy {
+  static std::uint16_t movemask(uint8x16_t eq) {
+    const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128,
+                             1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t m = vandq_u8(eq, bits);
+    return static_cast<std::uint16_t>(vaddv_u8(vget_low_u8(m))) |
+           static_cast<std::uint16_t>(vaddv_u8(vget_high_u8(m)) << 8);
+  }
+
+  static std::uint64_t eq_mask64(const char* block, char c) {
+    const uint8x16_t splat = vdupq_n_u8(static_cast<std::uint8_t>(c));
+    std::uint64_t mask = 0;
+    for (int v = 0; v < 4; ++v) {
+      const uint8x16_t bytes =
+          vld1q_u8(reinterpret_cast<const std::uint8_t*>(block) + v * 16);
+      mask |= static_cast<std::uint64_t>(movemask(vceqq_u8(bytes, splat)))
+              << (v * 16);
+    }
+    return mask;
+  }
+};
+using DefaultScanPolicy = NeonScanPolicy;
+#else
+using DefaultScanPolicy = ScalarScanPolicy;
+#endif
+
+template <class Policy = DefaultScanPolicy>
+class SimdScanner {
+ public:
+  static constexpr std::size_t kBlock = 64;
+
+  // Structural masks for one 64-byte block.
+  struct BlockMasks {
+    std::uint64_t newlines;
+    std::uint64_t quotes;
+    std::uint64_t backslashes;
+  };
+
+  static BlockMasks scan_block(const char* block) {
+    return {Policy::eq_mask64(block, '\n'), Policy::eq_mask64(block, '"'),
+            Policy::eq_mask64(block, '\\')};
+  }
+
+  // Appends the byte offset of every '\n' in `data` to `out`. Record
+  // boundaries are exactly these offsets; the caller slices between them.
+  static void find_newlines(std::string_view data,
+                            std::vector<std::uint64_t>& out) {
+    find_char(data, '\n', out);
+  }
+
+  // Generic structural-character positions (quotes, braces, ...).
+  static void find_char(std::string_view data, char c,
+                        std::vector<std::uint64_t>& out) {
+    EXYNOS_TRACE_SCOPE("scanner.find_char");
+    const char* p = data.data();
+    std::size_t n = data.size();
+    std::size_t base = 0;
+    while (n - base >= kBlock) {
+      emit(Policy::eq_mask64(p + base, c), base, out);
+      base += kBlock;
+    }
+    if (base < n) {
+      // Tail: copy into a zero-padded block; NUL never matches JSON
+      // structural characters.
+      char tail[kBlock] = {};
+      std::memcpy(tail, p + base, n - base);
+      std::uint64_t mask = Policy::eq_mask64(tail, c);
+      if (n - base < kBlock) mask &= (1ULL << (n - base)) - 1;
+      emit(mask, base, out);
+    }
+  }
+
+ private:
+  static void emit(std::uint64_t mask, std::size_t base,
+                   std::vector<std::uint64_t>& out) {
+    while (mask != 0) {
+      out.push_back(base + static_cast<std::size_t>(__builtin_ctzll(mask)));
+      mask &= mask - 1;
+    }
+  }
+};
+
+}  // namespace exynos::jsonl
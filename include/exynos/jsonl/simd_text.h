@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace exynos::jsonl {
+
+// Bulk text kernels for the compliance path: UTF-8 validation over every
+// ingested record and normalization of escaped JSON strings before
+// interning.
+//
+// Both kernels lead with the same 64-byte all-ASCII fast path the
+// structural scanner uses — one wide load and one reduction per block
+// (NEON vmaxv on the fleet, an OR-fold of 8-byte words elsewhere) — and
+// drop to byte-at-a-time only inside the rare blocks that actually carry
+// multibyte sequences or escapes. Log payloads are overwhelmingly ASCII,
+// so the fast path is the measured path and the Schema<...> parser stays
+// memory-bound with validation enabled.
+
+// True iff `data` is well-formed UTF-8 (rejects overlong encodings,
+// surrogate code points and anything past U+10FFFF).
+bool simd_validate_utf8(std::string_view data);
+
+// Normalizes the raw contents of a JSON string (the bytes between the
+// quotes) into `out`: resolves \" \\ \/ \b \f \n \r \t and \uXXXX
+// (including surrogate pairs, encoded as UTF-8). Replaces `out`. Returns
+// false on a malformed escape or an unpaired surrogate, leaving `out` in
+// an unspecified state. Escape-free spans copy 64 bytes at a time.
+bool simd_unescape(std::string_view in, std::string& out);
+
+}  // namespace exynos::jsonl
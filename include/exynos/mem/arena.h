@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <vector>
+
+namespace exynos::mem {
+
+// Bump-pointer region allocator.
+//
+// Allocation is a pointer increment inside the current block; a fresh
+// block is chained on only when the current one is exhausted. reset()
+// rewinds to empty but keeps the blocks, so a steady-state arena (one per
+// pipeline chunk) performs zero malloc calls per record. Not thread-safe
+// by design — each worker owns its arenas.
+class Arena {
+ public:
+  static constexpr std::size_t kDefaultBlockBytes = std::size_t{256} << 10;
+
+  explicit Arena(std::size_t block_bytes = kDefaultBlockBytes)
+      : block_bytes_(block_bytes) {}
+
+  Arena(Arena&&) noexcept = default;
+  Arena& operator=(Arena&&) noexcept = default;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+    std::uintptr_t p = reinterpret_cast<std::uintptr_t>(cur_);
+    std::uintptr_t aligned = (p + align - 1) & ~(align - 1);
+    if (aligned + size > reinterpret_cast<std::uintptr_t>(cur_end_)) {
+      grow(size + align);
+      p = reinterpret_cast<std::uintptr_t>(cur_);
+      aligned = (p + align - 1) & ~(align - 1);
+    }
+    cur_ = reinterpret_cast<char*>(aligned + size);
+    used_ += size;
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  template <typename T>
+  T* alloc_array(std::size_t n) {
+    return static_cast<T*>(allocate(n * sizeof(T), alignof(T)));
+  }
+
+  // Copies `s` into the arena; used when the source bytes (e.g. a
+  // Follower tail mapping) do not outlive the record.
+  std::string_view copy(std::string_view s) {
+    char* dst = alloc_array<char>(s.size());
+    std::memcpy(dst, s.data(), s.size());
+    return {dst, s.size()};
+  }
+
+  // Rewinds to empty without releasing blocks.
+  void reset() {
+    used_ = 0;
+    if (!blocks_.empty()) {
+      block_idx_ = 1;  // block 0 becomes the current block again
+      cur_ = blocks_[0].data.get();
+      cur_end_ = cur_ + blocks_[0].size;
+    } else {
+      block_idx_ = 0;
+      cur_ = cur_end_ = nullptr;
+    }
+  }
+
+  std::size_t bytes_used() const { return used_; }
+  std::size_t bytes_reserved() const { return reserved_; }
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size;
+  };
+
+  void grow(std::size_t min_bytes) {
+    // Reuse a retained block from a previous generation when possible.
+    while (block_idx_ < blocks_.size()) {
+      Block& b = blocks_[block_idx_++];
+      if (b.size >= min_bytes) {
+        cur_ = b.data.get();
+        cur_end_ = cur_ + b.size;
+        return;
+      }
+    }
+    std::size_t size = block_bytes_ > min_bytes ? block_bytes_ : min_bytes;
+    blocks_.push_back({std::unique_ptr<char[]>(new char[size]), size});
+    block_idx_ = blocks_.size();
+    reserved_ += size;
+    cur_ = blocks_.back().data.get();
+    cur_end_ = cur_ + size;
+  }
+
+  std::size_t block_bytes_;
+  std::vector<Block> blocks_;
+  std::size_t block_idx_ = 0;  // next retained block to hand out
+  char* cur_ = nullptr;
+  char* cur_end_ = nullptr;
+  std::size_t used_ = 0;
+  std::size_t reserved_ = 0;
+};
+
+}  // namespace exynos::mem
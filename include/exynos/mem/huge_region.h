@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace exynos::mem {
+
+// Opt-in huge-page placement for hot data.
+//
+// A multi-gigabyte mapping probed at random — the IdMap image, the
+// hottest column payloads — burns a measurable share of its probe cost
+// on dTLB misses at 4K granularity. HugeRegion allocates anonymous
+// memory preferring 2 MB pages: MAP_HUGETLB when the hugetlb pool has
+// capacity, otherwise a normal mapping flagged MADV_HUGEPAGE so khugepaged
+// collapses it (transparent huge pages), otherwise plain small pages.
+// Optionally the region is mlocked so memory pressure cannot page the
+// hot set out mid-query; lock failure (RLIMIT_MEMLOCK) is recorded, not
+// fatal.
+//
+// File-backed mappings cannot be MAP_HUGETLB, so the intended pattern is
+// copy-in: place a serialized image (IdMap, column payload) into a
+// region and reattach the zero-copy view on top of it — see
+// ColumnStore::id_index_pinned().
+//
+// Residency is sampled via mincore() and reported both from
+// resident_bytes() and through the trace surface (site
+// "huge_region.resident_kb") so `trace::dump` shows whether the hot set
+// actually stayed resident.
+class HugeRegion {
+ public:
+  enum class Backing { HugeTlb, TransparentHuge, Small };
+
+  struct Options {
+    bool lock = false;  // best-effort mlock after mapping
+  };
+
+  // Allocates `bytes` rounded up to the page size in use. Throws
+  // std::system_error when no mapping at all can be made.
+  explicit HugeRegion(std::size_t bytes) : HugeRegion(bytes, {}) {}
+  HugeRegion(std::size_t bytes, Options opts);
+  ~HugeRegion();
+
+  HugeRegion(HugeRegion&& other) noexcept;
+  HugeRegion& operator=(HugeRegion&&) = delete;
+  HugeRegion(const HugeRegion&) = delete;
+  HugeRegion& operator=(const HugeRegion&) = delete;
+
+  char* data() const { return static_cast<char*>(addr_); }
+  std::size_t size() const { return size_; }
+
+  Backing backing() const { return backing_; }
+  bool locked() const { return locked_; }
+
+  // Bytes of the region currently resident, sampled via mincore(); also
+  // records the sample under the "huge_region.resident_kb" trace site.
+  std::size_t resident_bytes() const;
+
+ private:
+  void* addr_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t page_size_ = 0;
+  Backing backing_ = Backing::Small;
+  bool locked_ = false;
+};
+
+}  // namespace exynos::mem
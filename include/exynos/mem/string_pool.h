@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "exynos/mem/arena.h"
+
+namespace exynos::mem {
+
+// Concurrent string interning pool producing dense 32-bit ids.
+//
+// Endpoint names, user agents and status strings repeat millions of times
+// across a feed; interning stores each distinct value once and hands out a
+// small id, so equality on the hot path is an integer compare and group-by
+// keys index straight into dense arrays. Ids are assigned in first-intern
+// order with no gaps, which is what ColumnStoreBuilder needs for
+// dictionary codes.
+//
+// Internally the hash table is sharded 16 ways (per-shard mutex, bytes in
+// a per-shard Arena) so pipeline workers intern concurrently without a
+// global lock, while id -> string resolution is lock-free: entries are
+// published into fixed-position slabs, so get() is safe from any thread
+// for any id the caller legitimately holds.
+class StringPool {
+ public:
+  static constexpr std::uint32_t kNpos = 0xFFFFFFFFu;
+
+  StringPool();
+  ~StringPool();
+
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+
+  // Returns the id for `s`, interning it first if unseen. The caller's
+  // bytes are copied; the view only needs to live for the call.
+  std::uint32_t intern(std::string_view s);
+
+  // Lookup without insertion: the id for `s`, or kNpos.
+  std::uint32_t find(std::string_view s) const;
+
+  // The interned bytes for `id`. `id` must have been returned by this
+  // pool's intern().
+  std::string_view get(std::uint32_t id) const;
+
+  // Number of distinct strings interned so far.
+  std::uint32_t size() const {
+    return next_id_.load(std::memory_order_acquire);
+  }
+
+  // Bytes held by the pool (string storage plus tables), for accounting.
+  std::size_t bytes_used() const;
+
+ private:
+  struct Entry {
+    const char* data;
+    std::uint32_t len;
+  };
+
+  static constexpr unsigned kShardCount = 16;
+  // Slab k holds (kBaseSlab << k) entries, so 22 doubling slabs cover the
+  // whole 32-bit id space while a small pool allocates one 4K-entry slab.
+  static constexpr unsigned kBaseSlabBits = 12;
+  static constexpr std::uint32_t kBaseSlab = 1u << kBaseSlabBits;
+  static constexpr unsigned kMaxSlabs = 22;
+
+  struct Shard {
+    mutable std::mutex mu;
+    // Open addressing, {hash, id} pairs; id == kNpos marks an empty slot.
+    struct Slot {
+      std::uint64_t hash;
+      std::uint32_t id;
+    };
+    std::vector<Slot> slots;
+    std::size_t used = 0;
+    Arena bytes;
+  };
+
+  Shard& shard_for(std::uint64_t h) const {
+    return shards_[(h >> 57) & (kShardCount - 1)];
+  }
+  std::uint32_t find_in(const Shard& s, std::uint64_t h,
+                        std::string_view str) const;
+  void grow(Shard& s) const;
+  void publish(std::uint32_t id, Entry e);
+
+  // Maps an id to its slab and offset within it.
+  static void locate(std::uint32_t id, unsigned& slab, std::uint32_t& off);
+
+  mutable Shard shards_[kShardCount];
+  std::atomic<std::uint32_t> next_id_{0};
+  std::mutex slab_mu_;
+  std::atomic<Entry*> slabs_[kMaxSlabs] = {};
+};
+
+}  // namespace exynos::mem
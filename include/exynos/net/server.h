@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/index/id_map.h"
+
+namespace exynos::net {
+
+// Serving surface for same-host consumers: a length-prefixed binary
+// protocol over a unix domain socket, run by one epoll loop on a
+// dedicated (optionally pinned) thread.
+//
+// Every frame is a u32 payload length followed by the payload, native
+// byte order (both ends share the host). Request payloads open with an
+// opcode byte:
+//
+//   kLookupBatch:  u32 n, then n of { u16 len, id bytes }.
+//     Response: status, u32 n, u64 offsets[n] (IdMap::kNotFound on miss).
+//   kColumnSlice:  u16 len, column name, u64 row_begin, u64 row_count.
+//     Response: status, u8 column type, u64 count, then the raw values
+//     (i64 for Int64, u32 dictionary codes for String). count may be
+//     less than requested — slices are clipped to the column and to the
+//     frame cap — so clients page with row_begin += count until count
+//     comes back 0.
+//
+// Response payloads open with a status byte (0 = ok; otherwise u16 len +
+// message follows). Clients may pipeline any number of request frames;
+// the loop answers everything parsed from one read with a single writev,
+// and slice payloads are iovec entries pointing straight into the
+// ColumnStore mapping — column bytes are never copied into a
+// serialization buffer on their way out.
+class Server {
+ public:
+  static constexpr std::uint8_t kLookupBatch = 1;
+  static constexpr std::uint8_t kColumnSlice = 2;
+
+  struct Options {
+    std::string socket_path;
+    // Pins the event-loop thread to this core when >= 0, keeping the
+    // serving path off the cores the pool is using.
+    int cpu = -1;
+  };
+
+  // Serves `store`, which must outlive the server. Throws
+  // std::system_error when the socket cannot be bound. The id index is
+  // deserialized once here, not per request.
+  Server(const cache::ColumnStore& store, Options opts);
+  ~Server();
+
+  Server(const Server&) = delete;
+  Server& operator=(const Server&) = delete;
+
+  std::uint64_t requests_served() const {
+    return requests_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Conn;
+
+  void loop();
+  bool handle_input(Conn& conn);
+  void flush(Conn& conn);
+
+  const cache::ColumnStore* store_;
+  std::optional<index::IdMap> id_index_;
+  Options opts_;
+  int listen_fd_ = -1;
+  int epoll_fd_ = -1;
+  std::atomic<bool> stop_{false};
+  std::atomic<std::uint64_t> requests_{0};
+  std::thread thread_;
+};
+
+// Blocking client for the protocol above; one connection, usable from
+// one thread at a time. Throws std::system_error on connection loss and
+// std::runtime_error on an error status from the server.
+class Client {
+ public:
+  explicit Client(const std::string& socket_path);
+  ~Client();
+
+  Client(const Client&) = delete;
+  Client& operator=(const Client&) = delete;
+
+  // One kLookupBatch round trip: offsets[i] answers ids[i],
+  // IdMap::kNotFound on miss.
+  std::vector<std::uint64_t> lookup_batch(
+      const std::vector<std::string_view>& ids);
+
+  struct Slice {
+    cache::ColumnType type;
+    std::string bytes;  // packed values, layout per the type
+  };
+  Slice column_slice(const std::string& column, std::uint64_t row_begin,
+                     std::uint64_t row_count);
+
+ private:
+  std::string roundtrip(const std::string& payload);
+
+  int fd_ = -1;
+};
+
+}  // namespace exynos::net
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/sched/steal_pool.h"
+
+namespace exynos::cache {
+class BlockStore;
+}
+
+namespace exynos::index {
+class TimeIndex;
+}
+
+namespace exynos::query {
+
+// Batched, vectorized filter + group-by + aggregate over a ColumnStore.
+//
+// Execution walks the table in 1024-row batches: each ANDed predicate
+// runs as a tight compare kernel over the batch producing a selection
+// byte-mask (NEON on the fleet; the scalar loops are written so the
+// compiler vectorizes them elsewhere), then the aggregate consumes only
+// selected rows. Group-by keys are dictionary codes, so grouping is an
+// array index, not a hash lookup. The canonical workload — count per
+// endpoint where latency_ms > X — touches two columns and nothing else.
+
+enum class CmpOp { Eq, Ne, Lt, Le, Gt, Ge };
+
+struct Predicate {
+  std::string column;
+  CmpOp op = CmpOp::Eq;
+  std::int64_t value = 0;   // Int64/Bool columns
+  std::string str_value;    // String columns (Eq/Ne only)
+};
+
+enum class AggOp { Count, Sum, Min, Max };
+
+struct Query {
+  std::vector<Predicate> filters;  // ANDed together
+  std::string group_by;            // String column; empty = single group
+  AggOp agg = AggOp::Count;
+  std::string agg_column;          // required for Sum/Min/Max
+};
+
+struct GroupResult {
+  std::string key;  // empty when the query has no group_by
+  std::int64_t value = 0;
+};
+
+struct Result {
+  std::vector<GroupResult> groups;  // sorted by value, descending
+  std::uint64_t rows_scanned = 0;
+  std::uint64_t rows_selected = 0;
+  std::uint64_t rows_pruned = 0;     // skipped via an attached TimeIndex
+  std::uint64_t blocks_skipped = 0;  // run_blocks only: zone-map skips
+};
+
+class Engine {
+ public:
+  static constexpr std::size_t kBatchRows = 1024;
+
+  // With a pool, batch ranges scan in parallel on the work-stealing
+  // workers (each range aggregates locally, partials merge at the end);
+  // without one, the scan is serial on the calling thread.
+  explicit Engine(const cache::ColumnStore& store,
+                  sched::StealPool* pool = nullptr)
+      : store_(&store), pool_(pool) {}
+
+  // Attaches a sorted timestamp index built over `column`. Range
+  // predicates on that column then prune whole row ranges up front, so a
+  // "last 5 minutes" window costs O(rows in window) instead of a full
+  // scan. The index must outlive the engine; the time predicates still
+  // run as filters inside the surviving ranges, so pruning never changes
+  // results.
+  void attach_time_index(std::string column, const index::TimeIndex* index) {
+    time_column_ = std::move(column);
+    time_index_ = index;
+  }
+
+  // Throws std::invalid_argument when the query names a missing column or
+  // mistypes one (e.g. integer compare against a string column).
+  Result run(const Query& query) const;
+
+  // Approximate top-k groups by row count. Same filters and group_by
+  // contract as run(), but instead of one accumulator per dictionary
+  // code it streams codes through a count-min sketch plus a k-entry
+  // candidate set (see sketch.h), so the working set stays a few hundred
+  // KB however large the dictionary is. Counts can overestimate by the
+  // sketch's collision noise; query.agg and agg_column are ignored
+  // (top-k is count-only). Respects an attached TimeIndex.
+  Result top_k(const Query& query, std::size_t k) const;
+
+  // Approximate count of distinct `column` values among rows passing the
+  // filters, via HyperLogLog (~1.6% standard error in 4 KB). Returns a
+  // single group whose value is the estimate; `column` must be a string
+  // column. Respects an attached TimeIndex.
+  Result distinct(const Query& query, const std::string& column) const;
+
+ private:
+  const cache::ColumnStore* store_;
+  sched::StealPool* pool_;
+  std::string time_column_;
+  const index::TimeIndex* time_index_ = nullptr;
+};
+
+// Runs `query` over a compressed cold-tier BlockStore. Blocks whose zone
+// maps cannot satisfy the ANDed filters are skipped before any
+// decompression (rows_scanned counts only decompressed blocks;
+// blocks_skipped reports the zone-map hits); surviving blocks decompress
+// just the referenced columns and evaluate row-at-a-time, which the
+// decompression cost dwarfs anyway. Same std::invalid_argument contract
+// as Engine::run.
+Result run_blocks(const cache::BlockStore& store, const Query& query);
+
+// Coroutine-pipelined variant of run_blocks: up to `window` block
+// fetch/decompress operations stay in flight on the pool while the scan
+// coroutine consumes completed blocks in order, so storage and
+// decompression overlap with compute instead of serializing per block.
+// Blocks the calling thread until the result is ready; identical results
+// and error contract to run_blocks.
+Result run_blocks_async(const cache::BlockStore& store, const Query& query,
+                        sched::StealPool& pool, std::size_t window = 4);
+
+}  // namespace exynos::query
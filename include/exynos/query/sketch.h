@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace exynos::query {
+
+// Space-bounded streaming summaries for high-cardinality aggregation.
+//
+// Exact per-group accumulators are arrays indexed by dictionary code, so
+// their working set grows with the dictionary; past a few hundred
+// thousand distinct values that no longer fits the mid-core L2 and every
+// row becomes a cache miss. The sketches here trade a bounded, tunable
+// error for a fixed footprint (a few hundred KB at the defaults) that
+// stays cache-resident no matter how many distinct keys stream through.
+// Keys are 64-bit values — callers feed dictionary codes straight in;
+// each sketch applies its own finalizing mix, so sequential codes spread
+// evenly.
+
+// Counting Bloom variant: `depth` rows of `width` counters, each add
+// increments one counter per row, estimate takes the minimum. Estimates
+// never undercount; collisions only inflate them, by roughly
+// total_adds/width per row in the worst case.
+class CountMinSketch {
+ public:
+  // `width` is rounded up to a power of two. The defaults give
+  // 4 x 8192 x 8 bytes = 256 KB.
+  explicit CountMinSketch(std::size_t width = 8192, std::size_t depth = 4);
+
+  void add(std::uint64_t key, std::uint64_t count = 1);
+  std::uint64_t estimate(std::uint64_t key) const;
+
+  // Cell-wise sum of another sketch with identical dimensions, for
+  // combining partial scans.
+  void merge(const CountMinSketch& other);
+
+  std::size_t bytes() const { return counters_.size() * sizeof(counters_[0]); }
+
+ private:
+  std::size_t width_;
+  std::size_t depth_;
+  std::vector<std::uint64_t> counters_;  // depth_ rows of width_ cells
+};
+
+// Heavy hitters over a stream: a CountMinSketch for counts plus a set of
+// the k current best candidates. A key enters the candidate set when its
+// estimate beats the smallest resident count, so the true top k survive
+// as long as their counts clear the sketch's overcount noise — which
+// they do by construction when they are heavy.
+class TopK {
+ public:
+  explicit TopK(std::size_t k, std::size_t width = 8192,
+                std::size_t depth = 4);
+
+  void add(std::uint64_t key);
+
+  struct Item {
+    std::uint64_t key = 0;
+    std::uint64_t count = 0;
+  };
+  // At most k items, count descending (ties by key ascending).
+  std::vector<Item> items() const;
+
+ private:
+  std::size_t k_;
+  CountMinSketch sketch_;
+  std::vector<Item> candidates_;  // unordered, at most k_
+  std::uint64_t min_count_ = 0;   // smallest candidate count when full
+};
+
+// HyperLogLog distinct counter: 2^precision one-byte registers, each
+// holding the longest run of leading zeros seen in its slice of the hash
+// space. Standard error is ~1.04/sqrt(2^precision) — about 1.6% at the
+// default precision 12, in 4 KB.
+class HyperLogLog {
+ public:
+  explicit HyperLogLog(unsigned precision = 12);
+
+  void add(std::uint64_t key);
+  std::uint64_t estimate() const;
+
+  // Register-wise max of another sketch with the same precision, for
+  // combining partial scans.
+  void merge(const HyperLogLog& other);
+
+  std::size_t bytes() const { return registers_.size(); }
+
+ private:
+  unsigned precision_;
+  std::vector<std::uint8_t> registers_;
+};
+
+}  // namespace exynos::query
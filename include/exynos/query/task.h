@@ -0,0 +1,125 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "exynos/sched/steal_pool.h"
+
+namespace exynos::query {
+
+// Minimal coroutine task for engine pipelines.
+//
+// A Task<T> is lazy: nothing runs until get() (or an enclosing co_await)
+// starts it. Once started it resumes wherever its awaited operations
+// complete — in practice a StealPool worker — so a query coroutine hops
+// between workers as fetches finish instead of blocking any one of them.
+// get() drives the task from a plain thread and blocks until the value
+// (or exception) is ready; nesting is via co_await, which chains
+// continuations with symmetric transfer.
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  struct promise_type {
+    std::optional<T> value;
+    std::exception_ptr error;
+    std::coroutine_handle<> continuation;
+    // Fired at final suspend; how get() learns the task finished.
+    void (*on_done)(void*) = nullptr;
+    void* on_done_arg = nullptr;
+
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    struct FinalAwaiter {
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(
+          std::coroutine_handle<promise_type> h) noexcept {
+        promise_type& p = h.promise();
+        // Read the continuation before firing on_done: the callback can
+        // wake get()'s thread, which may destroy the Task (and with it
+        // this frame) before we return.
+        const std::coroutine_handle<> next =
+            p.continuation ? p.continuation : std::noop_coroutine();
+        if (p.on_done != nullptr) p.on_done(p.on_done_arg);
+        return next;
+      }
+      void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void return_value(T v) { value.emplace(std::move(v)); }
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+
+  explicit Task(std::coroutine_handle<promise_type> h) : h_(h) {}
+  Task(Task&& other) noexcept : h_(std::exchange(other.h_, {})) {}
+  Task& operator=(Task&&) = delete;
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  ~Task() {
+    if (h_) h_.destroy();
+  }
+
+  // co_await support: starts the task and resumes the awaiter when it
+  // finishes.
+  auto operator co_await() && {
+    struct Awaiter {
+      std::coroutine_handle<promise_type> h;
+      bool await_ready() noexcept { return false; }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> cont) {
+        h.promise().continuation = cont;
+        return h;
+      }
+      T await_resume() {
+        if (h.promise().error) std::rethrow_exception(h.promise().error);
+        return std::move(*h.promise().value);
+      }
+    };
+    return Awaiter{h_};
+  }
+
+  // Runs the task to completion from a non-coroutine caller, blocking
+  // until the result is ready. Rethrows the task's exception, if any.
+  T get() {
+    struct Sync {
+      std::mutex mu;
+      std::condition_variable cv;
+      bool done = false;
+    } sync;
+    h_.promise().on_done = [](void* arg) {
+      auto* s = static_cast<Sync*>(arg);
+      std::lock_guard<std::mutex> lock(s->mu);
+      s->done = true;
+      s->cv.notify_one();
+    };
+    h_.promise().on_done_arg = &sync;
+    h_.resume();
+    std::unique_lock<std::mutex> lock(sync.mu);
+    sync.cv.wait(lock, [&] { return sync.done; });
+    if (h_.promise().error) std::rethrow_exception(h_.promise().error);
+    return std::move(*h_.promise().value);
+  }
+
+ private:
+  std::coroutine_handle<promise_type> h_;
+};
+
+// Awaitable that hops the current coroutine onto a StealPool worker:
+//   co_await schedule_on(pool);
+inline auto schedule_on(sched::StealPool& pool) {
+  struct Awaiter {
+    sched::StealPool* pool;
+    bool await_ready() noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) {
+      pool->submit([h] { h.resume(); });
+    }
+    void await_resume() noexcept {}
+  };
+  return Awaiter{&pool};
+}
+
+}  // namespace exynos::query
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace exynos::queue {
+
+// Fixed-capacity lock-free multi-producer single-consumer ring.
+//
+// Bounded Vyukov-style queue: each slot carries a sequence counter so
+// producers claim slots with a single CAS and publish with a release
+// store; the consumer observes slots with acquire loads. Head and tail
+// live on their own cache lines (64-byte lines on our ARM parts) so
+// producers and the consumer never false-share. The consumer drains up to
+// N elements per call, paying one synchronization per slot but no locks
+// anywhere.
+//
+// This is the standard inter-stage connector in ingest::Pipeline.
+template <typename T>
+class MpscRing {
+ public:
+  // `capacity` is rounded up to a power of two.
+  explicit MpscRing(std::size_t capacity) {
+    std::size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    mask_ = cap - 1;
+    slots_.reset(new Slot[cap]);
+    for (std::size_t i = 0; i < cap; ++i)
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  ~MpscRing() {
+    // Destroy any elements the consumer never drained.
+    for (;;) {
+      Slot& s = slots_[head_ & mask_];
+      if (static_cast<std::intptr_t>(s.seq.load(std::memory_order_acquire) -
+                                     (head_ + 1)) < 0)
+        break;
+      value(s)->~T();
+      ++head_;
+    }
+  }
+
+  MpscRing(const MpscRing&) = delete;
+  MpscRing& operator=(const MpscRing&) = delete;
+
+  std::size_t capacity() const { return mask_ + 1; }
+
+  // Any thread. Returns false when the ring is full.
+  bool try_push(T&& v) {
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& s = slots_[pos & mask_];
+      const std::size_t seq = s.seq.load(std::memory_order_acquire);
+      const auto dif =
+          static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if (dif == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          ::new (static_cast<void*>(s.storage)) T(std::move(v));
+          s.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false;  // full
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Consumer thread only. Appends up to `max` elements to `out`; returns
+  // the number drained.
+  std::size_t pop_batch(std::vector<T>& out, std::size_t max) {
+    std::size_t n = 0;
+    while (n < max) {
+      Slot& s = slots_[head_ & mask_];
+      const std::size_t seq = s.seq.load(std::memory_order_acquire);
+      if (static_cast<std::intptr_t>(seq) -
+              static_cast<std::intptr_t>(head_ + 1) < 0)
+        break;
+      T* v = value(s);
+      out.push_back(std::move(*v));
+      v->~T();
+      // Recycle the slot for the producer one lap ahead.
+      s.seq.store(head_ + mask_ + 1, std::memory_order_release);
+      ++head_;
+      ++n;
+    }
+    return n;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<std::size_t> seq;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  T* value(Slot& s) { return std::launder(reinterpret_cast<T*>(s.storage)); }
+
+  alignas(64) std::atomic<std::size_t> tail_{0};  // producers
+  alignas(64) std::size_t head_ = 0;              // consumer-owned
+  alignas(64) std::unique_ptr<Slot[]> slots_;
+  std::size_t mask_ = 0;
+};
+
+}  // namespace exynos::queue
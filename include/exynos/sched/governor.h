@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace exynos::sched {
+
+class StealPool;
+
+struct GovernorOptions {
+  // Roots are parameters so tests can point at synthetic trees.
+  std::string thermal_root = "/sys/class/thermal";
+  std::string cpu_root = "/sys/devices/system/cpu";
+  // 0 disables the poll thread; callers then drive poll_now() themselves.
+  std::chrono::milliseconds poll_interval{500};
+  // Stay this far (millidegrees C) below the passive trip point. The gap
+  // is the working band: background concurrency ramps down inside it and
+  // up below it.
+  long headroom_millic = 5000;
+  // Assumed trip when no zone exports one (containers, VMs).
+  long default_trip_millic = 95000;
+  unsigned min_workers = 1;
+  unsigned max_workers = 0;  // 0 = one per online core
+};
+
+// Thermal- and DVFS-aware pacing for background work.
+//
+// Sustained all-core ingest trips the SoC's passive throttle and then the
+// latency-critical lookup path runs at half clock too. The governor
+// samples the kernel thermal zones and cpufreq state and maintains a
+// background concurrency budget: additive increase while the chip is
+// cool, step down inside the headroom band, halve past the trip point or
+// whenever cpufreq is already clamping. Paced execution loses the burst
+// but wins every ten-minute window, because it never surrenders the
+// clocks the foreground needs.
+//
+// Background loops either wrap work items in acquire() — which blocks
+// while the chip is over budget — or run bulk work through
+// parallel_for_paced(), which keeps at most background_limit() of the
+// pool's workers busy.
+class Governor {
+ public:
+  explicit Governor(GovernorOptions opts = {});
+  ~Governor();
+
+  Governor(const Governor&) = delete;
+  Governor& operator=(const Governor&) = delete;
+
+  // Current background concurrency budget, in [min_workers, max_workers].
+  unsigned background_limit() const;
+  // Hottest zone from the last sample, millidegrees C (-1: no zones).
+  long max_temp_millic() const;
+  // Lowest passive/hot trip point discovered (default when none).
+  long trip_millic() const { return trip_millic_; }
+  // True when some cpu's current frequency sits well under its ceiling —
+  // the kernel is already clamping, back off regardless of temperature.
+  bool throttled() const;
+
+  // One synchronous sample-and-adjust step (the poll thread calls this).
+  void poll_now();
+
+  // Counted admission for one background work item; released on
+  // destruction. acquire() blocks while active leases >= the budget.
+  class Lease {
+   public:
+    ~Lease();
+    Lease(Lease&& other) noexcept;
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease& operator=(Lease&&) = delete;
+
+   private:
+    friend class Governor;
+    explicit Lease(Governor* gov) : gov_(gov) {}
+    Governor* gov_;
+  };
+  Lease acquire();
+
+  // StealPool::parallel_for with at most background_limit() chunks in
+  // flight, so a thermal ramp mid-run sheds workers between chunks.
+  void parallel_for_paced(StealPool& pool, std::size_t n,
+                          const std::function<void(std::size_t)>& fn);
+
+ private:
+  void release();
+  long read_trip() const;
+
+  GovernorOptions opts_;
+  long trip_millic_ = 0;
+  std::vector<std::string> zone_temp_paths_;
+
+  mutable std::mutex mu_;
+  std::condition_variable lease_cv_;
+  unsigned limit_ = 1;
+  unsigned active_ = 0;
+  long last_temp_millic_ = -1;
+  bool last_throttled_ = false;
+
+  std::thread poll_thread_;
+  std::condition_variable stop_cv_;
+  bool stopping_ = false;
+};
+
+}  // namespace exynos::sched
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace exynos::sched {
+
+// Work-stealing task pool sized for asymmetric (big.LITTLE) topologies.
+//
+// Each worker owns a deque: it pushes and pops its own work LIFO for
+// cache locality and steals FIFO from randomized victims when empty, so
+// fast Cortex-X workers drain stragglers' queues instead of idling.
+// External submission is spread by capacity weight — each worker's weight
+// is its core's cpufreq ceiling relative to the fastest core, read once
+// at startup — so LITTLE cores start with proportionally less work and
+// the steal path only corrects the remainder.
+//
+// Workers know their DSU cluster (from sched::Topology) and steal from
+// same-cluster victims first, crossing clusters only when their whole
+// cluster is dry: a stolen task's data usually sits in the victim's L2/L3
+// slice, and keeping the thief behind the same slice avoids dragging it
+// across the DSU. submit_on_cluster() lets callers place related work —
+// a chunk's parse, interning and column appends — on one cluster outright.
+//
+// ingest::Pipeline and query::Engine run their chunk/batch work on this.
+class StealPool {
+ public:
+  using Task = std::function<void()>;
+
+  // 0 = one worker per online core.
+  explicit StealPool(unsigned workers = 0);
+  ~StealPool();
+
+  StealPool(const StealPool&) = delete;
+  StealPool& operator=(const StealPool&) = delete;
+
+  unsigned worker_count() const { return static_cast<unsigned>(workers_.size()); }
+  // Capacity weight of worker `w` in (0, 1]; 1.0 on homogeneous machines.
+  double weight(unsigned w) const { return weights_[w]; }
+
+  // Clusters spanned by the workers (1 on homogeneous machines).
+  unsigned cluster_count() const {
+    return static_cast<unsigned>(cluster_workers_.size());
+  }
+  unsigned worker_cluster(unsigned w) const { return worker_cluster_[w]; }
+
+  // Callable from any thread, including from inside tasks.
+  void submit(Task task);
+  // Targets a worker on the given cluster (round-robin within it), so a
+  // task lands behind the same L3 slice as its predecessors there.
+  void submit_on_cluster(unsigned cluster, Task task);
+  // Blocks until every submitted task (and everything they spawned) ran.
+  // A task that threw does not kill its worker; the first such exception
+  // is latched and rethrown here (later ones are dropped).
+  void wait_idle();
+
+  // Runs fn(0..n-1) across the pool and waits. Chunked internally so the
+  // per-index overhead stays amortized.
+  void parallel_for(std::size_t n, const std::function<void(std::size_t)>& fn);
+
+ private:
+  struct Worker {
+    std::deque<Task> queue;
+    std::mutex mu;
+    std::thread thread;
+  };
+
+  void worker_loop(unsigned self);
+  bool try_pop(unsigned self, Task& task);
+  bool try_steal(unsigned self, Task& task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<double> weights_;
+  std::vector<unsigned> submit_schedule_;  // weighted round-robin targets
+  std::vector<unsigned> worker_cluster_;   // worker -> DSU cluster
+  std::vector<std::vector<unsigned>> cluster_workers_;
+  std::vector<std::size_t> cluster_ticket_;  // guarded by idle_mu_
+
+  std::mutex idle_mu_;
+  std::condition_variable idle_cv_;
+  std::condition_variable work_cv_;
+  std::size_t outstanding_ = 0;
+  std::size_t submit_ticket_ = 0;
+  std::exception_ptr task_error_;  // first uncaught task exception
+  bool stopping_ = false;
+};
+
+}  // namespace exynos::sched
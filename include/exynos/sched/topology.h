@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace exynos::sched {
+
+// CPU topology snapshot parsed from sysfs at startup.
+//
+// On Exynos parts the DSU shares the L3 slice between clusters, so work
+// that bounces between clusters pays coherence traffic through it. The
+// placement decisions in StealPool and ingest::Pipeline key off the
+// cluster map discovered here: cluster ids come from
+// cpuN/topology/cluster_id (package id on older kernels, LLC sharing as
+// the last resort), capacity from cpufreq ceilings, and cache sizes from
+// cpuN/cache/index*.
+//
+// The sysfs root is a constructor parameter so tests can point it at a
+// synthetic tree; production code uses the system() singleton.
+class Topology {
+ public:
+  explicit Topology(
+      const std::string& sysfs_cpu_root = "/sys/devices/system/cpu");
+
+  // Detected once on first use; shared by every pool in the process.
+  static const Topology& system();
+
+  unsigned cpu_count() const { return static_cast<unsigned>(cpus_.size()); }
+  unsigned cluster_count() const {
+    return static_cast<unsigned>(clusters_.size());
+  }
+  unsigned cluster_of(unsigned cpu) const { return cpus_[cpu].cluster; }
+  const std::vector<unsigned>& cpus_in(unsigned cluster) const {
+    return clusters_[cluster];
+  }
+  // cpufreq ceiling in kHz, -1 where cpufreq is absent (VMs, containers).
+  long max_freq_khz(unsigned cpu) const { return cpus_[cpu].max_freq_khz; }
+  // Size of the largest cache level above the cpu, 0 if not reported.
+  std::uint64_t llc_bytes(unsigned cpu) const { return cpus_[cpu].llc_bytes; }
+
+ private:
+  struct Cpu {
+    unsigned cluster = 0;
+    long max_freq_khz = -1;
+    std::uint64_t llc_bytes = 0;
+  };
+
+  std::vector<Cpu> cpus_;
+  std::vector<std::vector<unsigned>> clusters_;  // cluster -> member cpus
+};
+
+}  // namespace exynos::sched
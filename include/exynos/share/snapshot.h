@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "exynos/cache/column_store.h"
+
+namespace exynos::share {
+
+// Cross-process snapshot serving.
+//
+// One publisher process (the ingester) seals the loaded .exycol image —
+// columns plus the embedded IdMap — into an anonymous memfd and flips a
+// tiny control file to point at it. Consumer processes (serving,
+// analytics, alerting) attach in O(1): they seqlock-read the control
+// header, open the publisher's memfd through /proc/<pid>/fd, and mmap it
+// read-only. The kernel shares the pages, so N consumers cost one copy
+// of the dataset instead of N on RAM-constrained boards.
+//
+// The memfd is sealed (SHRINK|GROW|WRITE|SEAL) before it is published;
+// readers verify the seals on attach, which also defends against the
+// publisher's fd number being reused between the seqlock read and the
+// /proc open. After compaction the publisher seals a fresh memfd and
+// bumps the epoch; readers poll stale() and re-attach at their own pace.
+// The superseded memfd stays open until the publish after next so a
+// reader mid-attach never chases a closed fd.
+
+// Control file layout: one 64-byte seqlock-guarded header. `seq` is odd
+// while the publisher is mid-flip; `pid` and `fd` name the sealed memfd
+// as /proc/<pid>/fd/<fd>.
+struct SnapshotControl {
+  static constexpr std::uint64_t kMagic = 0x3150414E53595845ULL;  // "EXYSNAP1"
+  std::uint64_t magic;
+  std::uint64_t seq;
+  std::int32_t pid;
+  std::int32_t fd;
+  std::uint64_t bytes;
+  std::uint64_t reserved[4];
+};
+static_assert(sizeof(SnapshotControl) == 64);
+
+class SnapshotPublisher {
+ public:
+  // Creates (or adopts) the control file at `control_path`. Consumers
+  // attach by the same path; put it somewhere tmpfs-backed.
+  explicit SnapshotPublisher(const std::string& control_path);
+  ~SnapshotPublisher();
+
+  SnapshotPublisher(const SnapshotPublisher&) = delete;
+  SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+  // Seals `len` bytes into a fresh memfd and flips the control header to
+  // it. Returns the new epoch (monotone, even).
+  std::uint64_t publish(const void* data, std::size_t len);
+  // Publishes the byte image of an existing file (the .exycol cache).
+  std::uint64_t publish_file(const std::string& path);
+
+  std::uint64_t epoch() const;
+
+ private:
+  SnapshotControl* ctrl_ = nullptr;
+  int current_fd_ = -1;
+  int retired_fd_ = -1;  // previous snapshot; closed on the next publish
+};
+
+class Snapshot {
+ public:
+  // Attaches to the snapshot currently published at `control_path`.
+  // Throws std::runtime_error if nothing has been published yet.
+  static Snapshot attach(const std::string& control_path);
+
+  ~Snapshot();
+  Snapshot(Snapshot&& other) noexcept;
+  Snapshot& operator=(Snapshot&& other) noexcept;
+
+  const char* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  std::uint64_t epoch() const { return epoch_; }
+
+  // True once the publisher has flipped to a newer snapshot; re-attach to
+  // pick it up. This snapshot's mapping stays valid regardless.
+  bool stale() const;
+
+  // Path naming this snapshot's bytes through the attaching process's own
+  // fd — stable even after the publisher moves on or exits.
+  std::string memfd_path() const;
+  // Zero-copy ColumnStore over the shared segment (same pages, no load).
+  cache::ColumnStore open_store() const { return cache::ColumnStore(memfd_path()); }
+
+ private:
+  Snapshot() = default;
+
+  const SnapshotControl* ctrl_ = nullptr;
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::uint64_t epoch_ = 0;
+  int fd_ = -1;  // our dup of the publisher's memfd
+};
+
+}  // namespace exynos::share
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace exynos::io {
+class UringWriter;
+}
+
+namespace exynos::sched {
+class StealPool;
+}
+
+namespace exynos::sort {
+
+// Out-of-core sort for compaction: deltas arrive in arrival order but the
+// sealed output wants global timestamp order, and a full day of records
+// does not fit in RAM.
+//
+// add() accumulates fixed 16-byte entries (timestamp key + source offset)
+// into a bounded buffer; each time the buffer fills, it is radix-sorted
+// on the key and spilled to a run file — on a StealPool worker when a
+// pool is given, so sorting and spilling overlap with the caller
+// producing the next run. merge_to() then k-way merges every run with a
+// loser tree (log2(k) comparisons per output entry instead of a heap's
+// 2*log2(k)) and streams the merged entries straight into a UringWriter,
+// so the merge runs at storage bandwidth: each input byte is read once
+// from the page cache and written once.
+//
+// Memory stays bounded by ~2x run_entries entries (sort ping-pong
+// scratch) plus the output batch, independent of total volume.
+class ExternalMerge {
+ public:
+  // Sorted 16-byte record: `key` is the timestamp, `value` the record's
+  // byte offset in the source log. Ties order by value, so replays of
+  // the same instant keep their arrival order.
+  struct Entry {
+    std::int64_t key = 0;
+    std::uint64_t value = 0;
+  };
+
+  struct Options {
+    // Run files are written as <run_prefix>.run0, .run1, ... and removed
+    // when the sorter is destroyed.
+    std::string run_prefix = "external_merge";
+    // Entries buffered per run: 1M entries = 16 MB resident per run
+    // (plus the same again in sort scratch).
+    std::size_t run_entries = 1 << 20;
+    // With a pool, sealed runs sort and spill on pool workers while the
+    // caller keeps filling the next buffer; without one, inline.
+    sched::StealPool* pool = nullptr;
+  };
+
+  explicit ExternalMerge(Options opts);
+  ~ExternalMerge();
+
+  ExternalMerge(const ExternalMerge&) = delete;
+  ExternalMerge& operator=(const ExternalMerge&) = delete;
+
+  // Single-producer: buffers one entry, spilling a sorted run when the
+  // buffer is full.
+  void add(std::int64_t key, std::uint64_t value);
+
+  // Merges everything added so far into `out` as packed Entry records
+  // starting at offset 0, flushes the writer, and returns the entry
+  // count. One-shot: the sorter is empty afterwards (run files removed).
+  // A spill that failed on a pool worker rethrows here, before the merge
+  // touches any run.
+  std::uint64_t merge_to(io::UringWriter& out);
+
+  // Runs spilled so far (excludes the in-memory tail).
+  std::size_t run_count() const;
+
+ private:
+  void spill(std::vector<Entry>&& buf, std::size_t run);
+  void wait_spills() const;
+
+  Options opts_;
+  std::vector<Entry> buffer_;
+  std::size_t runs_ = 0;
+
+  mutable std::mutex mu_;
+  mutable std::condition_variable spills_done_;
+  std::size_t pending_spills_ = 0;
+  std::exception_ptr spill_error_;  // first pool-spill failure, unreported
+};
+
+}  // namespace exynos::sort
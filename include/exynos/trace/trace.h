@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+// Near-zero-overhead hot-path instrumentation.
+//
+// Scopes time code regions in raw cycle units read straight from the
+// counter register (cntvct_el0 on the fleet, rdtsc on x86 build hosts) and
+// accumulate into thread-local log2 histograms; Counters count events the
+// same way. Nothing on the record path takes a lock — registration happens
+// once per (site, thread) and dump() aggregates across threads on demand.
+//
+// The whole surface compiles out when EXYNOS_TRACE_ENABLED is 0: the
+// classes are templates over the enable flag whose disabled specialization
+// is an empty type, and the site macros expand to nothing that touches the
+// registry.
+
+#ifndef EXYNOS_TRACE_ENABLED
+#define EXYNOS_TRACE_ENABLED 1
+#endif
+
+namespace exynos::trace {
+
+constexpr bool kEnabled = EXYNOS_TRACE_ENABLED != 0;
+
+inline std::uint64_t cycles() {
+#if defined(__aarch64__)
+  std::uint64_t v;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#elif defined(__x86_64__)
+  std::uint32_t lo, hi;
+  asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+  return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#else
+  return 0;
+#endif
+}
+
+namespace detail {
+
+// Per-(site, thread) accumulator; owned by the registry, written lock-free
+// by exactly one thread.
+struct SiteStats {
+  const char* name;
+  std::uint64_t count = 0;
+  std::uint64_t total = 0;  // cycles for scopes, event sum for counters
+  std::uint64_t buckets[64] = {};  // log2(cycles) histogram
+
+  void record(std::uint64_t v) {
+    ++count;
+    total += v;
+    ++buckets[v == 0 ? 0 : 63 - __builtin_clzll(v)];  // floor(log2(v))
+  }
+  void add(std::uint64_t n) {
+    ++count;
+    total += n;
+  }
+};
+
+// Registers and returns this thread's stats block for `name`.
+SiteStats* site(const char* name);
+
+}  // namespace detail
+
+// Aggregated dump of every site across all threads: count, total cycles,
+// mean, and approximate p50/p99 from the log2 histogram.
+void dump(std::FILE* out);
+// Forgets all recorded data (sites stay registered). Primarily for tests.
+void reset();
+
+template <bool Enabled>
+class ScopeImpl {
+ public:
+  explicit ScopeImpl(detail::SiteStats* stats)
+      : stats_(stats), start_(cycles()) {}
+  ~ScopeImpl() { stats_->record(cycles() - start_); }
+
+  ScopeImpl(const ScopeImpl&) = delete;
+  ScopeImpl& operator=(const ScopeImpl&) = delete;
+
+ private:
+  detail::SiteStats* stats_;
+  std::uint64_t start_;
+};
+
+template <>
+class ScopeImpl<false> {
+ public:
+  explicit ScopeImpl(detail::SiteStats*) {}
+};
+
+template <bool Enabled>
+class CounterImpl {
+ public:
+  explicit CounterImpl(detail::SiteStats* stats) : stats_(stats) {}
+  void add(std::uint64_t n = 1) { stats_->add(n); }
+
+ private:
+  detail::SiteStats* stats_;
+};
+
+template <>
+class CounterImpl<false> {
+ public:
+  explicit CounterImpl(detail::SiteStats*) {}
+  void add(std::uint64_t = 1) {}
+};
+
+using Scope = ScopeImpl<kEnabled>;
+using Counter = CounterImpl<kEnabled>;
+
+}  // namespace exynos::trace
+
+#define EXYNOS_TRACE_CAT_(a, b) a##b
+#define EXYNOS_TRACE_CAT(a, b) EXYNOS_TRACE_CAT_(a, b)
+
+#if EXYNOS_TRACE_ENABLED
+// Times the rest of the enclosing block under `name`.
+#define EXYNOS_TRACE_SCOPE(name)                                             \
+  static thread_local ::exynos::trace::detail::SiteStats*                    \
+      EXYNOS_TRACE_CAT(exytrace_site_, __LINE__) =                           \
+          ::exynos::trace::detail::site(name);                               \
+  ::exynos::trace::Scope EXYNOS_TRACE_CAT(exytrace_scope_, __LINE__)(        \
+      EXYNOS_TRACE_CAT(exytrace_site_, __LINE__))
+// Declares a counter handle named `var` for site `name`.
+#define EXYNOS_TRACE_COUNTER(var, name)                               \
+  static thread_local ::exynos::trace::detail::SiteStats*             \
+      exytrace_ctr_##var = ::exynos::trace::detail::site(name);       \
+  ::exynos::trace::Counter var(exytrace_ctr_##var)
+#else
+#define EXYNOS_TRACE_SCOPE(name) ((void)0)
+#define EXYNOS_TRACE_COUNTER(var, name) \
+  ::exynos::trace::Counter var(nullptr)
+#endif
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace exynos::wal {
+
+struct JournalOptions {
+  std::string path;
+  // Group commit: the batch fsyncs when it reaches this many bytes...
+  std::size_t flush_bytes = 256 << 10;
+  // ...or when this much time has passed with dirty entries buffered.
+  // 0 disables the timer thread; only the size threshold (and explicit
+  // sync()) commit.
+  std::chrono::milliseconds flush_interval{50};
+};
+
+// Crash-consistent write-ahead journal for the in-memory delta.
+//
+// Records tailed in between compactions exist only in the delta; a
+// reboot would lose them. Every append is framed (length, CRC32, source
+// offset, payload) into an in-memory batch that group-commits on a size
+// threshold or a timer, so durability costs one fsync per batch — in
+// practice one per thousand records — instead of one per record.
+//
+// Recovery replays every intact frame front to back and truncates the
+// first torn frame (a crash mid-write) and everything after it. Replay
+// is one sequential read, so startup after a crash is bounded by journal
+// size, which compaction keeps small: once the delta seals into a
+// segment the journal resets to empty. A crash between seal and reset
+// replays already-sealed records into the delta again — harmless, since
+// id lookups are last-write-wins and the duplicate rows fold away at the
+// next compaction.
+class Journal {
+ public:
+  explicit Journal(JournalOptions opts);
+  ~Journal();  // best-effort flush of whatever is still buffered
+
+  Journal(const Journal&) = delete;
+  Journal& operator=(const Journal&) = delete;
+
+  // Replays intact frames into `cb` in append order and truncates any
+  // torn tail. Call once, before the first append.
+  std::size_t replay(
+      const std::function<void(std::string_view, std::uint64_t)>& cb);
+
+  // Buffers one record frame; durable after the next group commit. A
+  // commit failure from the timer thread is latched and rethrown here
+  // (or from sync()), since those threads have no caller to tell.
+  void append(std::string_view record, std::uint64_t offset);
+
+  // Forces the buffered batch to disk now; returns once durable.
+  void sync();
+
+  // Empties the journal (after the delta it covers has been sealed).
+  void reset();
+
+  std::uint64_t appended() const;
+  // Group commits so far; appended()/commits() is the amortization.
+  std::uint64_t commits() const;
+
+ private:
+  // Writes and fsyncs the batch; returns 0 or the failing errno. Never
+  // throws — the timer thread and the destructor have nowhere to catch.
+  int commit_locked() noexcept;
+  void throw_if_failed_locked();
+
+  JournalOptions opts_;
+  int fd_ = -1;
+
+  mutable std::mutex mu_;
+  std::string batch_;
+  int sticky_errno_ = 0;  // first timer-thread commit failure, unreported
+  std::uint64_t appended_ = 0;
+  std::uint64_t commits_ = 0;
+
+  std::thread flush_thread_;
+  std::condition_variable stop_cv_;
+  bool stopping_ = false;
+};
+
+}  // namespace exynos::wal
@@ -0,0 +1,237 @@
+#include "exynos/cache/block_store.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/io/uring_writer.h"
+#include "exynos/trace/trace.h"
+
+#if defined(EXYNOS_HAVE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace exynos::cache {
+
+namespace {
+
+constexpr std::uint64_t kAlign = 64;
+
+std::uint64_t align_up(std::uint64_t off) {
+  return (off + kAlign - 1) & ~(kAlign - 1);
+}
+
+void append(std::string& out, const void* data, std::size_t len) {
+  out.append(static_cast<const char*>(data), len);
+}
+
+// Compresses `raw` with the requested codec. Falls back to storing raw
+// bytes when compression does not shrink the chunk, which the reader
+// detects as comp_len == raw_len.
+std::string compress_chunk(BlockCodec codec, const std::string& raw) {
+  if (codec == BlockCodec::None || raw.empty()) return raw;
+#if defined(EXYNOS_HAVE_ZSTD)
+  std::string out;
+  out.resize(ZSTD_compressBound(raw.size()));
+  const std::size_t n = ZSTD_compress(out.data(), out.size(), raw.data(),
+                                      raw.size(), /*level=*/3);
+  if (ZSTD_isError(n) || n >= raw.size()) return raw;
+  out.resize(n);
+  return out;
+#else
+  throw std::runtime_error("zstd support not compiled in");
+#endif
+}
+
+}  // namespace
+
+BlockCodec preferred_codec() {
+#if defined(EXYNOS_HAVE_ZSTD)
+  return BlockCodec::Zstd;
+#else
+  return BlockCodec::None;
+#endif
+}
+
+void BlockStoreWriter::write(const ColumnStore& source, const std::string& path,
+                             Options opts) {
+  EXYNOS_TRACE_SCOPE("block_store.write");
+  if (opts.block_rows == 0) opts.block_rows = 1;
+  const std::uint64_t nrows = source.rows();
+  const std::uint32_t ncols = source.columns();
+  const std::uint64_t nblocks =
+      nrows == 0 ? 0 : (nrows + opts.block_rows - 1) / opts.block_rows;
+
+  BlockFileHeader header{};
+  header.magic = BlockFileHeader::kMagic;
+  header.version = 1;
+  header.column_count = ncols;
+  header.block_count = nblocks;
+  header.row_count = nrows;
+  header.codec = static_cast<std::uint32_t>(opts.codec);
+  header.block_rows = opts.block_rows;
+
+  std::vector<BlockColumnInfo> infos(ncols);
+  for (std::uint32_t c = 0; c < ncols; ++c) {
+    const ColumnStore::Column col = source.at(c);
+    std::memset(infos[c].name, 0, sizeof(infos[c].name));
+    const std::string_view name = col.name();
+    std::memcpy(infos[c].name, name.data(), name.size());
+    infos[c].type = static_cast<std::uint8_t>(col.type());
+  }
+
+  std::vector<ChunkDesc> dir(nblocks * ncols);
+  std::vector<std::string> payloads(nblocks * ncols);
+
+  for (std::uint64_t b = 0; b < nblocks; ++b) {
+    const std::uint64_t row0 = b * opts.block_rows;
+    const std::uint32_t rows = static_cast<std::uint32_t>(
+        std::min<std::uint64_t>(opts.block_rows, nrows - row0));
+    for (std::uint32_t c = 0; c < ncols; ++c) {
+      const ColumnStore::Column col = source.at(c);
+      ChunkDesc& desc = dir[b * ncols + c];
+      desc.min = std::numeric_limits<std::int64_t>::max();
+      desc.max = std::numeric_limits<std::int64_t>::min();
+
+      std::string raw;
+      switch (col.type()) {
+        case ColumnType::Int64:
+          append(raw, col.ints() + row0, rows * sizeof(std::int64_t));
+          for (std::uint32_t r = 0; r < rows; ++r)
+            if (col.is_valid(row0 + r)) {
+              desc.min = std::min(desc.min, col.ints()[row0 + r]);
+              desc.max = std::max(desc.max, col.ints()[row0 + r]);
+            }
+          break;
+        case ColumnType::Double:
+          append(raw, col.doubles() + row0, rows * sizeof(double));
+          break;
+        case ColumnType::Bool:
+          append(raw, col.bools() + row0, rows);
+          for (std::uint32_t r = 0; r < rows; ++r)
+            if (col.is_valid(row0 + r)) {
+              desc.min = std::min<std::int64_t>(desc.min, col.bools()[row0 + r]);
+              desc.max = std::max<std::int64_t>(desc.max, col.bools()[row0 + r]);
+            }
+          break;
+        case ColumnType::String: {
+          // Remap global dictionary codes to a block-local dictionary so
+          // the chunk decompresses self-contained.
+          std::unordered_map<std::uint32_t, std::uint32_t> local;
+          std::vector<std::uint32_t> codes(rows, 0);
+          std::vector<std::uint32_t> local_globals;
+          for (std::uint32_t r = 0; r < rows; ++r) {
+            if (!col.is_valid(row0 + r)) continue;
+            const std::uint32_t g = col.codes()[row0 + r];
+            auto [it, inserted] = local.try_emplace(
+                g, static_cast<std::uint32_t>(local_globals.size()));
+            if (inserted) local_globals.push_back(g);
+            codes[r] = it->second;
+          }
+          std::vector<std::uint64_t> offsets;
+          std::string bytes;
+          offsets.push_back(0);
+          for (std::uint32_t g : local_globals) {
+            bytes += col.dict_entry(g);
+            offsets.push_back(bytes.size());
+          }
+          const std::uint64_t dict_n = local_globals.size();
+          append(raw, codes.data(), codes.size() * sizeof(std::uint32_t));
+          raw.resize((raw.size() + 7) & ~std::size_t{7}, '\0');  // align u64s
+          append(raw, &dict_n, sizeof(dict_n));
+          append(raw, offsets.data(), offsets.size() * sizeof(std::uint64_t));
+          append(raw, bytes.data(), bytes.size());
+          break;
+        }
+      }
+      std::vector<std::uint8_t> valid((rows + 7) / 8, 0);
+      for (std::uint32_t r = 0; r < rows; ++r)
+        if (col.is_valid(row0 + r))
+          valid[r >> 3] |= static_cast<std::uint8_t>(1u << (r & 7));
+      append(raw, valid.data(), valid.size());
+
+      desc.raw_len = raw.size();
+      payloads[b * ncols + c] = compress_chunk(opts.codec, raw);
+      desc.comp_len = payloads[b * ncols + c].size();
+    }
+  }
+
+  std::uint64_t off = sizeof(header) + infos.size() * sizeof(BlockColumnInfo) +
+                      dir.size() * sizeof(ChunkDesc);
+  for (ChunkDesc& d : dir) {
+    off = align_up(off);
+    d.off = off;
+    off += d.comp_len;
+  }
+
+  io::UringWriter writer(path);
+  writer.write_at(0, &header, sizeof(header));
+  writer.write_at(sizeof(header), infos.data(),
+                  infos.size() * sizeof(BlockColumnInfo));
+  writer.write_at(sizeof(header) + infos.size() * sizeof(BlockColumnInfo),
+                  dir.data(), dir.size() * sizeof(ChunkDesc));
+  for (std::size_t i = 0; i < payloads.size(); ++i)
+    writer.write_at(dir[i].off, payloads[i].data(), payloads[i].size());
+  writer.close();
+}
+
+BlockStore::BlockStore(const std::string& path) : map_(path) {
+  if (map_.size() < sizeof(BlockFileHeader))
+    throw std::runtime_error(path + ": not an exyblk file");
+  header_ = reinterpret_cast<const BlockFileHeader*>(map_.data().data());
+  if (header_->magic != BlockFileHeader::kMagic)
+    throw std::runtime_error(path + ": bad exyblk magic");
+  const std::uint64_t dir_end =
+      sizeof(BlockFileHeader) +
+      header_->column_count * sizeof(BlockColumnInfo) +
+      header_->block_count * header_->column_count * sizeof(ChunkDesc);
+  if (map_.size() < dir_end)
+    throw std::runtime_error(path + ": truncated block directory");
+  columns_ = reinterpret_cast<const BlockColumnInfo*>(map_.data().data() +
+                                                      sizeof(BlockFileHeader));
+  chunks_ = reinterpret_cast<const ChunkDesc*>(
+      map_.data().data() + sizeof(BlockFileHeader) +
+      header_->column_count * sizeof(BlockColumnInfo));
+}
+
+std::uint32_t BlockStore::block_row_count(std::uint64_t block) const {
+  const std::uint64_t row0 = block * header_->block_rows;
+  return static_cast<std::uint32_t>(
+      std::min<std::uint64_t>(header_->block_rows, header_->row_count - row0));
+}
+
+std::string_view BlockStore::column_name(std::uint32_t col) const {
+  const char* name = columns_[col].name;
+  return {name, ::strnlen(name, sizeof(columns_[col].name))};
+}
+
+std::optional<std::uint32_t> BlockStore::find_column(
+    std::string_view name) const {
+  for (std::uint32_t c = 0; c < header_->column_count; ++c)
+    if (column_name(c) == name) return c;
+  return std::nullopt;
+}
+
+std::string_view BlockStore::read_chunk(std::uint64_t block, std::uint32_t col,
+                                        std::vector<char>& scratch) const {
+  const ChunkDesc& desc = chunk(block, col);
+  const char* src = map_.data().data() + desc.off;
+  if (desc.comp_len == desc.raw_len)  // stored raw, serve from the mapping
+    return {src, desc.raw_len};
+#if defined(EXYNOS_HAVE_ZSTD)
+  EXYNOS_TRACE_SCOPE("block_store.decompress");
+  scratch.resize(desc.raw_len);
+  const std::size_t n =
+      ZSTD_decompress(scratch.data(), scratch.size(), src, desc.comp_len);
+  if (ZSTD_isError(n) || n != desc.raw_len)
+    throw std::runtime_error("corrupt compressed chunk");
+  return {scratch.data(), scratch.size()};
+#else
+  (void)scratch;
+  throw std::runtime_error("zstd support not compiled in");
+#endif
+}
+
+}  // namespace exynos::cache
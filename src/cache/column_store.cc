@@ -0,0 +1,309 @@
+#include "exynos/cache/column_store.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include "exynos/io/uring_writer.h"
+
+namespace exynos::cache {
+
+namespace {
+
+constexpr std::uint64_t kAlign = 64;
+
+std::uint64_t align_up(std::uint64_t off) {
+  return (off + kAlign - 1) & ~(kAlign - 1);
+}
+
+ColumnType type_for(const jsonl::Value& v) {
+  switch (v.type) {
+    case jsonl::ValueType::Int:
+      return ColumnType::Int64;
+    case jsonl::ValueType::Double:
+      return ColumnType::Double;
+    case jsonl::ValueType::Bool:
+      return ColumnType::Bool;
+    default:
+      return ColumnType::String;  // String and Raw both dictionary-encode
+  }
+}
+
+}  // namespace
+
+void ColumnStoreBuilder::ColumnBuild::pad_to(std::uint64_t row) {
+  while (filled < row) {
+    switch (type) {
+      case ColumnType::Int64:
+        ints.push_back(0);
+        break;
+      case ColumnType::Double:
+        doubles.push_back(0.0);
+        break;
+      case ColumnType::Bool:
+        bools.push_back(0);
+        break;
+      case ColumnType::String:
+        codes.push_back(0);
+        break;
+    }
+    ++filled;  // validity bit stays 0: the row is null for this column
+  }
+  valid.resize((filled + 7) / 8, 0);
+}
+
+void ColumnStoreBuilder::ColumnBuild::mark_valid(std::uint64_t row) {
+  valid.resize(row / 8 + 1, 0);
+  valid[row >> 3] |= static_cast<std::uint8_t>(1u << (row & 7));
+}
+
+ColumnStoreBuilder::ColumnBuild& ColumnStoreBuilder::column(
+    std::string_view name, ColumnType type) {
+  for (ColumnBuild& c : columns_)
+    if (c.name == name) return c;
+  ColumnBuild c;
+  c.name = std::string(name);
+  c.type = type;
+  if (type == ColumnType::String) c.dict = std::make_shared<mem::StringPool>();
+  columns_.push_back(std::move(c));
+  return columns_.back();
+}
+
+void ColumnStoreBuilder::add(jsonl::RecordView record) {
+  const std::uint64_t row = rows_;
+  for (std::uint32_t fi = 0; fi < record.count; ++fi) {
+    const jsonl::Field& f = record.fields[fi];
+    if (f.value.type == jsonl::ValueType::Null) continue;
+    if (f.key.size() >= sizeof(ColumnDesc{}.name)) continue;  // oversize key
+    ColumnBuild& col = column(f.key, type_for(f.value));
+    col.pad_to(row);
+    if (col.filled != row) continue;  // duplicate key in one record
+    // Type fixed at first occurrence; mismatched later values stay null.
+    if (col.type != type_for(f.value)) {
+      continue;
+    }
+    switch (col.type) {
+      case ColumnType::Int64:
+        col.ints.push_back(f.value.i);
+        break;
+      case ColumnType::Double:
+        col.doubles.push_back(f.value.d);
+        break;
+      case ColumnType::Bool:
+        col.bools.push_back(f.value.b ? 1 : 0);
+        break;
+      case ColumnType::String:
+        col.codes.push_back(col.dict->intern(f.value.s));
+        break;
+    }
+    col.mark_valid(row);
+    ++col.filled;
+  }
+  ++rows_;
+}
+
+void ColumnStoreBuilder::write(const std::string& path,
+                               std::uint64_t source_size,
+                               std::int64_t source_mtime_ns) const {
+  // Snapshot the builds padded out to the full row count.
+  std::vector<ColumnBuild> cols = columns_;
+  for (ColumnBuild& c : cols) c.pad_to(rows_);
+
+  FileHeader header{};
+  header.magic = FileHeader::kMagic;
+  header.version = 2;
+  header.column_count = static_cast<std::uint32_t>(cols.size());
+  header.row_count = rows_;
+  header.source_size = source_size;
+  header.source_mtime_ns = source_mtime_ns;
+
+  std::vector<ColumnDesc> dir(cols.size());
+  std::uint64_t off =
+      sizeof(FileHeader) + dir.size() * sizeof(ColumnDesc);
+
+  struct Blob {
+    std::uint64_t off;
+    const void* data;
+    std::uint64_t len;
+  };
+  std::vector<Blob> blobs;
+  // Dictionary offset tables are materialized here so their storage
+  // outlives the layout pass.
+  std::vector<std::vector<std::uint64_t>> dict_offsets(cols.size());
+  std::vector<std::string> dict_bytes(cols.size());
+
+  auto place = [&](std::uint64_t& desc_off, std::uint64_t& desc_len,
+                   const void* data, std::uint64_t len) {
+    off = align_up(off);
+    desc_off = off;
+    desc_len = len;
+    blobs.push_back({off, data, len});
+    off += len;
+  };
+
+  for (std::size_t i = 0; i < cols.size(); ++i) {
+    const ColumnBuild& c = cols[i];
+    ColumnDesc& d = dir[i];
+    std::memset(d.name, 0, sizeof(d.name));
+    std::memcpy(d.name, c.name.data(), c.name.size());
+    d.type = static_cast<std::uint8_t>(c.type);
+    switch (c.type) {
+      case ColumnType::Int64:
+        place(d.data_off, d.data_len, c.ints.data(),
+              c.ints.size() * sizeof(std::int64_t));
+        break;
+      case ColumnType::Double:
+        place(d.data_off, d.data_len, c.doubles.data(),
+              c.doubles.size() * sizeof(double));
+        break;
+      case ColumnType::Bool:
+        place(d.data_off, d.data_len, c.bools.data(), c.bools.size());
+        break;
+      case ColumnType::String: {
+        place(d.data_off, d.data_len, c.codes.data(),
+              c.codes.size() * sizeof(std::uint32_t));
+        auto& offsets = dict_offsets[i];
+        auto& bytes = dict_bytes[i];
+        offsets.push_back(0);
+        for (std::uint32_t code = 0; code < c.dict->size(); ++code) {
+          bytes += c.dict->get(code);
+          offsets.push_back(bytes.size());
+        }
+        place(d.dict_offsets_off, d.dict_offsets_len, offsets.data(),
+              offsets.size() * sizeof(std::uint64_t));
+        place(d.dict_bytes_off, d.dict_bytes_len, bytes.data(), bytes.size());
+        break;
+      }
+    }
+    place(d.valid_off, d.valid_len, c.valid.data(), c.valid.size());
+  }
+
+  if (!index_image_.empty())
+    place(header.index_off, header.index_len, index_image_.data(),
+          index_image_.size());
+
+  // Positional writes through the async writer: alignment gaps become
+  // file holes (zeros under mmap) instead of explicit pad writes, and the
+  // blobs overlap in flight instead of serializing on write(2).
+  io::UringWriter writer(path);
+  writer.write_at(0, &header, sizeof(header));
+  writer.write_at(sizeof(header), dir.data(), dir.size() * sizeof(ColumnDesc));
+  for (const Blob& b : blobs) writer.write_at(b.off, b.data, b.len);
+  writer.close();
+}
+
+ColumnStore::ColumnStore(const std::string& path) : map_(path) {
+  if (map_.size() < sizeof(FileHeader))
+    throw std::runtime_error(path + ": not an exycol file");
+  header_ = reinterpret_cast<const FileHeader*>(map_.data().data());
+  if (header_->magic != FileHeader::kMagic)
+    throw std::runtime_error(path + ": bad exycol magic");
+  const std::uint64_t dir_end =
+      sizeof(FileHeader) + header_->column_count * sizeof(ColumnDesc);
+  if (map_.size() < dir_end)
+    throw std::runtime_error(path + ": truncated column directory");
+  dir_ = reinterpret_cast<const ColumnDesc*>(map_.data().data() +
+                                             sizeof(FileHeader));
+}
+
+bool ColumnStore::up_to_date(const std::string& path,
+                             std::uint64_t source_size,
+                             std::int64_t source_mtime_ns) {
+  std::FILE* f = std::fopen(path.c_str(), "rb");
+  if (f == nullptr) return false;
+  FileHeader header;
+  bool ok = std::fread(&header, sizeof(header), 1, f) == 1;
+  std::fclose(f);
+  return ok && header.magic == FileHeader::kMagic && header.version == 2 &&
+         header.source_size == source_size &&
+         header.source_mtime_ns == source_mtime_ns;
+}
+
+std::string_view ColumnStore::Column::name() const {
+  return {desc_->name, ::strnlen(desc_->name, sizeof(desc_->name))};
+}
+
+const std::int64_t* ColumnStore::Column::ints() const {
+  return reinterpret_cast<const std::int64_t*>(base_ + desc_->data_off);
+}
+
+const double* ColumnStore::Column::doubles() const {
+  return reinterpret_cast<const double*>(base_ + desc_->data_off);
+}
+
+const std::uint8_t* ColumnStore::Column::bools() const {
+  return reinterpret_cast<const std::uint8_t*>(base_ + desc_->data_off);
+}
+
+const std::uint32_t* ColumnStore::Column::codes() const {
+  return reinterpret_cast<const std::uint32_t*>(base_ + desc_->data_off);
+}
+
+std::uint64_t ColumnStore::Column::dict_size() const {
+  return desc_->dict_offsets_len / sizeof(std::uint64_t) - 1;
+}
+
+std::string_view ColumnStore::Column::dict_entry(std::uint32_t code) const {
+  const auto* offsets =
+      reinterpret_cast<const std::uint64_t*>(base_ + desc_->dict_offsets_off);
+  return {base_ + desc_->dict_bytes_off + offsets[code],
+          static_cast<std::size_t>(offsets[code + 1] - offsets[code])};
+}
+
+std::string_view ColumnStore::Column::str(std::uint64_t row) const {
+  return dict_entry(codes()[row]);
+}
+
+std::optional<ColumnStore::Column> ColumnStore::find(
+    std::string_view name) const {
+  for (std::uint32_t i = 0; i < header_->column_count; ++i) {
+    Column col = at(i);
+    if (col.name() == name) return col;
+  }
+  return std::nullopt;
+}
+
+ColumnStore::Column ColumnStore::at(std::uint32_t idx) const {
+  return Column(&dir_[idx], map_.data().data());
+}
+
+std::optional<index::IdMap> ColumnStore::id_index() const {
+  if (header_->index_len == 0) return std::nullopt;
+  if (header_->index_off + header_->index_len > map_.size()) return std::nullopt;
+  return index::IdMap::view(map_.data().data() + header_->index_off,
+                            header_->index_len);
+}
+
+std::optional<index::IdMap> ColumnStore::id_index_pinned(
+    mem::HugeRegion& region) const {
+  const std::uint64_t len = id_index_bytes();
+  if (len == 0) return std::nullopt;
+  if (region.size() < len)
+    throw std::invalid_argument("huge region smaller than id index image");
+  std::memcpy(region.data(), map_.data().data() + header_->index_off, len);
+  return index::IdMap::view(region.data(), len);
+}
+
+ColumnStore open_or_build(const std::string& jsonl_path,
+                          const std::string& cache_path) {
+  jsonl::MmapReader source(jsonl_path);
+  if (!ColumnStore::up_to_date(cache_path, source.source_size(),
+                               source.source_mtime_ns())) {
+    ColumnStoreBuilder builder;
+    index::IdMap ids;
+    jsonl::Record rec;
+    for (std::string_view line : source) {
+      if (!parse_record(line, rec)) continue;
+      if (const jsonl::Value* id = rec.find("id");
+          id != nullptr && id->type == jsonl::ValueType::String)
+        ids.insert(id->s, static_cast<std::uint64_t>(line.data() -
+                                                     source.data().data()));
+      builder.add(rec);
+    }
+    builder.set_id_index(ids);
+    builder.write(cache_path, source.source_size(), source.source_mtime_ns());
+  }
+  return ColumnStore(cache_path);
+}
+
+}  // namespace exynos::cache
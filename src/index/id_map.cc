@@ -0,0 +1,236 @@
+#include "exynos/index/id_map.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace exynos::index {
+
+namespace {
+
+constexpr std::uint8_t kEmpty = 0x80;
+constexpr std::uint64_t kGroup = 16;
+
+struct IdxHeader {
+  std::uint64_t magic;
+  std::uint64_t capacity;
+  std::uint64_t size;
+  std::uint64_t reserved[5];  // pads the header to one 64-byte line
+};
+static_assert(sizeof(IdxHeader) == 64);
+
+// 16-bit mask of control bytes equal to `byte`.
+inline std::uint32_t match16(const std::uint8_t* ctrl, std::uint8_t byte) {
+#if defined(__ARM_NEON)
+  const uint8x16_t eq = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(byte));
+  const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128,
+                           1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t m = vandq_u8(eq, bits);
+  return static_cast<std::uint32_t>(vaddv_u8(vget_low_u8(m))) |
+         static_cast<std::uint32_t>(vaddv_u8(vget_high_u8(m))) << 8;
+#else
+  std::uint32_t mask = 0;
+  const std::uint64_t splat = 0x0101010101010101ULL * byte;
+  for (int w = 0; w < 2; ++w) {
+    std::uint64_t word;
+    std::memcpy(&word, ctrl + w * 8, 8);
+    const std::uint64_t x = word ^ splat;
+    const std::uint64_t t =
+        ~(((x | 0x8080808080808080ULL) - 0x0101010101010101ULL) | x) &
+        0x8080808080808080ULL;
+    mask |= static_cast<std::uint32_t>(((t >> 7) * 0x0102040810204080ULL) >> 56)
+            << (w * 8);
+  }
+  return mask;
+#endif
+}
+
+inline std::uint8_t h2_of(std::uint64_t h) {
+  return static_cast<std::uint8_t>(h & 0x7F);
+}
+
+inline std::uint64_t h1_of(std::uint64_t h) { return h >> 7; }
+
+}  // namespace
+
+std::uint64_t IdMap::hash(std::string_view id) {
+  // FNV-1a with a 64-bit avalanche finish; ids are short, this is already
+  // memory-bound on the probe, not the hash.
+  std::uint64_t h = 0xCBF29CE484222325ULL;
+  for (unsigned char c : id) {
+    h ^= c;
+    h *= 0x100000001B3ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+void IdMap::reserve(std::uint64_t ids) {
+  std::uint64_t needed = ids + ids / 4;  // keep load under ~0.8
+  while (capacity_ < needed) grow();
+}
+
+void IdMap::grow() {
+  if (view_) throw std::runtime_error("IdMap: cannot grow a mapped view");
+  const std::uint64_t new_cap = capacity_ == 0 ? 64 : capacity_ * 2;
+  std::vector<std::uint8_t> old_ctrl = std::move(ctrl_store_);
+  std::vector<Slot> old_slots = std::move(slot_store_);
+  const std::uint64_t old_cap = capacity_;
+
+  ctrl_store_.assign(new_cap, kEmpty);
+  slot_store_.assign(new_cap, Slot{0, 0});
+  ctrl_ = ctrl_store_.data();
+  slots_ = slot_store_.data();
+  capacity_ = new_cap;
+  size_ = 0;
+
+  for (std::uint64_t i = 0; i < old_cap; ++i)
+    if ((old_ctrl[i] & kEmpty) == 0)
+      insert_no_grow(old_slots[i].hash, old_slots[i].offset);
+}
+
+void IdMap::insert_no_grow(std::uint64_t h, std::uint64_t offset) {
+  const std::uint64_t groups = capacity_ / kGroup;
+  const std::uint8_t h2 = h2_of(h);
+  std::uint64_t g = h1_of(h) & (groups - 1);
+  for (;;) {
+    const std::uint8_t* gctrl = ctrl_ + g * kGroup;
+    std::uint32_t hits = match16(gctrl, h2);
+    while (hits != 0) {
+      const std::uint32_t i = static_cast<std::uint32_t>(__builtin_ctz(hits));
+      Slot& s = slot_store_[g * kGroup + i];
+      if (s.hash == h) {
+        s.offset = offset;  // same id seen again: last write wins
+        return;
+      }
+      hits &= hits - 1;
+    }
+    std::uint32_t empties = match16(gctrl, kEmpty);
+    if (empties != 0) {
+      const std::uint32_t i = static_cast<std::uint32_t>(__builtin_ctz(empties));
+      ctrl_store_[g * kGroup + i] = h2;
+      slot_store_[g * kGroup + i] = {h, offset};
+      ++size_;
+      return;
+    }
+    g = (g + 1) & (groups - 1);
+  }
+}
+
+void IdMap::insert_hash(std::uint64_t h, std::uint64_t offset) {
+  if (capacity_ == 0 || size_ + 1 > capacity_ - capacity_ / 8) grow();
+  insert_no_grow(h, offset);
+}
+
+std::optional<std::uint64_t> IdMap::find_hash(std::uint64_t h) const {
+  if (size_ == 0) return std::nullopt;
+  const std::uint64_t groups = capacity_ / kGroup;
+  const std::uint8_t h2 = h2_of(h);
+  std::uint64_t g = h1_of(h) & (groups - 1);
+  for (std::uint64_t probed = 0; probed < groups; ++probed) {
+    const std::uint8_t* gctrl = ctrl_ + g * kGroup;
+    std::uint32_t hits = match16(gctrl, h2);
+    while (hits != 0) {
+      const std::uint32_t i = static_cast<std::uint32_t>(__builtin_ctz(hits));
+      const Slot& s = slots_[g * kGroup + i];
+      if (s.hash == h) return s.offset;
+      hits &= hits - 1;
+    }
+    if (match16(gctrl, kEmpty) != 0) return std::nullopt;
+    g = (g + 1) & (groups - 1);
+  }
+  return std::nullopt;
+}
+
+void IdMap::lookup_batch_hash(std::span<const std::uint64_t> hashes,
+                              std::span<std::uint64_t> offsets) const {
+  if (hashes.size() != offsets.size())
+    throw std::invalid_argument("IdMap: batch spans differ in length");
+  if (size_ == 0) {
+    std::fill(offsets.begin(), offsets.end(), kNotFound);
+    return;
+  }
+  const std::uint64_t groups = capacity_ / kGroup;
+  // Pipeline depth: far enough ahead to cover a DRAM fetch, close enough
+  // that the lines are still resident when their probe comes around. The
+  // control and slot groups share the home-group index, so one address
+  // computation covers both prefetches.
+  constexpr std::size_t kAhead = 8;
+  auto prefetch = [&](std::uint64_t h) {
+    const std::uint64_t g = h1_of(h) & (groups - 1);
+    __builtin_prefetch(ctrl_ + g * kGroup, 0, 1);
+    __builtin_prefetch(slots_ + g * kGroup, 0, 1);
+  };
+  const std::size_t n = hashes.size();
+  for (std::size_t i = 0; i < std::min(kAhead, n); ++i) prefetch(hashes[i]);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i + kAhead < n) prefetch(hashes[i + kAhead]);
+    const auto hit = find_hash(hashes[i]);
+    offsets[i] = hit ? *hit : kNotFound;
+  }
+}
+
+void IdMap::lookup_batch(std::span<const std::string_view> ids,
+                         std::span<std::uint64_t> offsets) const {
+  if (ids.size() != offsets.size())
+    throw std::invalid_argument("IdMap: batch spans differ in length");
+  // Hash a tile ahead of the probe loop so the prefetch window always has
+  // computed hashes to work from.
+  constexpr std::size_t kTile = 256;
+  std::uint64_t hashes[kTile];
+  for (std::size_t base = 0; base < ids.size(); base += kTile) {
+    const std::size_t n = std::min(kTile, ids.size() - base);
+    for (std::size_t i = 0; i < n; ++i) hashes[i] = hash(ids[base + i]);
+    lookup_batch_hash({hashes, n}, offsets.subspan(base, n));
+  }
+}
+
+std::vector<std::uint8_t> IdMap::serialize() const {
+  IdxHeader header{};
+  header.magic = kMagic;
+  header.capacity = capacity_;
+  header.size = size_;
+
+  const std::uint64_t ctrl_len = (capacity_ + 63) & ~std::uint64_t{63};
+  std::vector<std::uint8_t> out(sizeof(IdxHeader) + ctrl_len +
+                                capacity_ * sizeof(Slot));
+  std::memcpy(out.data(), &header, sizeof(header));
+  if (capacity_ != 0) {
+    std::memcpy(out.data() + sizeof(header), ctrl_, capacity_);
+    std::memset(out.data() + sizeof(header) + capacity_, kEmpty,
+                ctrl_len - capacity_);
+    std::memcpy(out.data() + sizeof(header) + ctrl_len, slots_,
+                capacity_ * sizeof(Slot));
+  }
+  return out;
+}
+
+IdMap IdMap::view(const void* data, std::size_t len) {
+  if (len < sizeof(IdxHeader)) throw std::runtime_error("IdMap: short image");
+  IdxHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kMagic) throw std::runtime_error("IdMap: bad magic");
+  const std::uint64_t ctrl_len = (header.capacity + 63) & ~std::uint64_t{63};
+  if (len < sizeof(IdxHeader) + ctrl_len + header.capacity * sizeof(Slot))
+    throw std::runtime_error("IdMap: truncated image");
+
+  IdMap map;
+  map.view_ = true;
+  map.capacity_ = header.capacity;
+  map.size_ = header.size;
+  const auto* base = static_cast<const std::uint8_t*>(data);
+  map.ctrl_ = base + sizeof(IdxHeader);
+  map.slots_ =
+      reinterpret_cast<const Slot*>(base + sizeof(IdxHeader) + ctrl_len);
+  return map;
+}
+
+}  // namespace exynos::index
@@ -0,0 +1,80 @@
+#include "exynos/index/time_index.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace exynos::index {
+
+TimeIndex::TimeIndex(const std::int64_t* ts, const std::uint8_t* valid,
+                     std::uint64_t rows, std::uint64_t bucket_rows) {
+  if (bucket_rows == 0) bucket_rows = 1;
+  min_ts_ = std::numeric_limits<std::int64_t>::max();
+  max_ts_ = std::numeric_limits<std::int64_t>::min();
+  std::int64_t prev_min = std::numeric_limits<std::int64_t>::min();
+  std::int64_t prev_max = std::numeric_limits<std::int64_t>::min();
+  for (std::uint64_t begin = 0; begin < rows; begin += bucket_rows) {
+    const std::uint64_t end = std::min(rows, begin + bucket_rows);
+    Bucket b;
+    b.begin = begin;
+    b.end = end;
+    b.min = std::numeric_limits<std::int64_t>::max();
+    b.max = std::numeric_limits<std::int64_t>::min();
+    for (std::uint64_t row = begin; row < end; ++row) {
+      if (valid != nullptr && (valid[row >> 3] & (1u << (row & 7))) == 0)
+        continue;
+      b.min = std::min(b.min, ts[row]);
+      b.max = std::max(b.max, ts[row]);
+    }
+    // All-null buckets (min > max) stay in the vector and the overlap
+    // test rejects them outright; they also break the partitioning the
+    // binary search needs, so their presence forces the linear walk.
+    if (b.min > b.max) {
+      sorted_ = false;
+    } else {
+      min_ts_ = std::min(min_ts_, b.min);
+      max_ts_ = std::max(max_ts_, b.max);
+      // Sorted means both bound sequences are nondecreasing over the
+      // non-empty buckets; that is what the binary search relies on.
+      if (b.min < prev_min || b.max < prev_max) sorted_ = false;
+      prev_min = b.min;
+      prev_max = b.max;
+    }
+    buckets_.push_back(b);
+  }
+  if (min_ts_ > max_ts_) {  // no indexed rows at all
+    min_ts_ = 0;
+    max_ts_ = -1;
+  }
+}
+
+std::vector<RowRange> TimeIndex::query(std::int64_t lo, std::int64_t hi) const {
+  std::vector<RowRange> out;
+  if (buckets_.empty() || lo > hi || hi < min_ts_ || lo > max_ts_) return out;
+
+  std::size_t first = 0;
+  std::size_t last = buckets_.size();
+  if (sorted_) {
+    // First bucket that can still reach `lo`, and first past `hi`.
+    first = static_cast<std::size_t>(
+        std::lower_bound(
+            buckets_.begin(), buckets_.end(), lo,
+            [](const Bucket& b, std::int64_t v) { return b.max < v; }) -
+        buckets_.begin());
+    last = static_cast<std::size_t>(
+        std::upper_bound(
+            buckets_.begin(), buckets_.end(), hi,
+            [](std::int64_t v, const Bucket& b) { return v < b.min; }) -
+        buckets_.begin());
+  }
+  for (std::size_t i = first; i < last; ++i) {
+    const Bucket& b = buckets_[i];
+    if (b.min > b.max || b.max < lo || b.min > hi) continue;
+    if (!out.empty() && out.back().end == b.begin)
+      out.back().end = b.end;  // coalesce adjacent survivors
+    else
+      out.push_back({b.begin, b.end});
+  }
+  return out;
+}
+
+}  // namespace exynos::index
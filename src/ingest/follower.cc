@@ -0,0 +1,150 @@
+#include "exynos/ingest/follower.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace exynos::ingest {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+constexpr int kPollMs = 100;  // rotation/missed-event backstop
+
+}  // namespace
+
+Follower::Follower(std::string path, Callback on_record)
+    : path_(std::move(path)), on_record_(std::move(on_record)) {}
+
+Follower::~Follower() {
+  stop();
+  if (fd_ >= 0) ::close(fd_);
+  if (inotify_fd_ >= 0) ::close(inotify_fd_);
+}
+
+void Follower::open_source() {
+  int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) throw_errno("open " + path_);
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw_errno("fstat " + path_);
+  }
+  if (fd_ >= 0) ::close(fd_);
+  fd_ = fd;
+  ino_ = st.st_ino;
+  processed_.store(0, std::memory_order_relaxed);
+  if (inotify_fd_ >= 0) {
+    // Watch follows the path, not the fd, so rotation re-arms naturally.
+    if (::inotify_add_watch(inotify_fd_, path_.c_str(),
+                            IN_MODIFY | IN_MOVE_SELF) < 0)
+      throw_errno("inotify_add_watch " + path_);
+  }
+}
+
+bool Follower::rotated() const {
+  struct stat st;
+  if (::stat(path_.c_str(), &st) != 0) return false;  // gone: wait for new
+  return st.st_ino != ino_;
+}
+
+void Follower::drain_growth() {
+  struct stat st;
+  if (::fstat(fd_, &st) != 0) return;
+  const std::uint64_t size = static_cast<std::uint64_t>(st.st_size);
+  std::uint64_t processed = processed_.load(std::memory_order_relaxed);
+  if (size <= processed) return;
+
+  // Remap only the grown tail, aligned down to a page.
+  const std::uint64_t page = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+  const std::uint64_t map_begin = processed & ~(page - 1);
+  const std::uint64_t map_len = size - map_begin;
+  void* map = ::mmap(nullptr, map_len, PROT_READ, MAP_PRIVATE, fd_,
+                     static_cast<off_t>(map_begin));
+  if (map == MAP_FAILED) return;  // transient; retried on next wakeup
+  const char* base = static_cast<const char*>(map);
+
+  std::uint64_t pos = processed;
+  while (pos < size) {
+    const char* start = base + (pos - map_begin);
+    const void* nl = ::memchr(start, '\n', size - pos);
+    if (nl == nullptr) break;  // torn final line: wait for its newline
+    const std::size_t len =
+        static_cast<std::size_t>(static_cast<const char*>(nl) - start);
+    if (len != 0) on_record_(std::string_view(start, len), pos);
+    pos += len + 1;
+  }
+  processed_.store(pos, std::memory_order_relaxed);
+  ::munmap(map, map_len);
+}
+
+void Follower::poll_once() {
+  if (fd_ < 0) {
+    // Single-threaded use without start(): open lazily on first poll.
+    try {
+      open_source();
+    } catch (const std::system_error&) {
+      return;
+    }
+  }
+  drain_growth();
+  if (rotated()) {
+    // Old generation fully drained above (writers to a renamed file are a
+    // producer bug on our side); switch to the new inode from offset 0.
+    try {
+      open_source();
+    } catch (const std::system_error&) {
+      return;  // new file not ready yet; next poll retries
+    }
+    drain_growth();
+  }
+}
+
+void Follower::start() {
+  if (running_.load()) return;
+  inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0) throw_errno("inotify_init1");
+  if (::pipe2(wakeup_pipe_, O_CLOEXEC | O_NONBLOCK) != 0)
+    throw_errno("pipe2");
+  open_source();
+  // Records appended before start() are part of the replay path, not the
+  // follow path: the catch-up pass emits them before we block.
+  running_.store(true);
+  thread_ = std::thread([this] { run(); });
+}
+
+void Follower::run() {
+  poll_once();
+  while (running_.load(std::memory_order_relaxed)) {
+    struct pollfd fds[2] = {{inotify_fd_, POLLIN, 0},
+                            {wakeup_pipe_[0], POLLIN, 0}};
+    ::poll(fds, 2, kPollMs);
+    if (fds[0].revents & POLLIN) {
+      char buf[4096];
+      while (::read(inotify_fd_, buf, sizeof(buf)) > 0) {
+      }
+    }
+    poll_once();
+  }
+}
+
+void Follower::stop() {
+  if (!running_.exchange(false)) return;
+  (void)!::write(wakeup_pipe_[1], "x", 1);
+  if (thread_.joinable()) thread_.join();
+  ::close(wakeup_pipe_[0]);
+  ::close(wakeup_pipe_[1]);
+  wakeup_pipe_[0] = wakeup_pipe_[1] = -1;
+}
+
+}  // namespace exynos::ingest
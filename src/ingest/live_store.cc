@@ -0,0 +1,328 @@
+#include "exynos/ingest/live_store.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace exynos::ingest {
+
+namespace {
+
+// Scalar predicate evaluation for delta rows. The delta is bounded by the
+// compaction threshold, so row-at-a-time here never sees more than a few
+// hundred thousand records.
+bool matches(const query::Query& q, jsonl::RecordView rec) {
+  for (const query::Predicate& p : q.filters) {
+    const jsonl::Value* v = rec.find(p.column);
+    if (v == nullptr) return false;
+    bool ok = false;
+    if (v->type == jsonl::ValueType::String) {
+      const bool eq = v->s == p.str_value;
+      ok = p.op == query::CmpOp::Eq ? eq
+           : p.op == query::CmpOp::Ne ? !eq
+                                      : false;
+    } else if (v->type == jsonl::ValueType::Int ||
+               v->type == jsonl::ValueType::Bool) {
+      const std::int64_t x =
+          v->type == jsonl::ValueType::Int ? v->i : (v->b ? 1 : 0);
+      switch (p.op) {
+        case query::CmpOp::Eq: ok = x == p.value; break;
+        case query::CmpOp::Ne: ok = x != p.value; break;
+        case query::CmpOp::Lt: ok = x < p.value; break;
+        case query::CmpOp::Le: ok = x <= p.value; break;
+        case query::CmpOp::Gt: ok = x > p.value; break;
+        case query::CmpOp::Ge: ok = x >= p.value; break;
+      }
+    }
+    if (!ok) return false;
+  }
+  return true;
+}
+
+struct MergedGroup {
+  std::int64_t value = 0;
+  bool seen = false;
+};
+
+void merge_value(query::AggOp op, std::int64_t v, MergedGroup& g) {
+  if (!g.seen) {
+    g.value = v;
+    g.seen = true;
+    return;
+  }
+  switch (op) {
+    case query::AggOp::Count:
+    case query::AggOp::Sum:
+      g.value += v;
+      break;
+    case query::AggOp::Min:
+      g.value = std::min(g.value, v);
+      break;
+    case query::AggOp::Max:
+      g.value = std::max(g.value, v);
+      break;
+  }
+}
+
+// TimeIndex over the store's time column; null when the column is absent,
+// not Int64, or indexing is disabled.
+std::unique_ptr<index::TimeIndex> build_time_index(
+    const cache::ColumnStore& store, const std::string& column) {
+  if (column.empty() || store.rows() == 0) return nullptr;
+  auto col = store.find(column);
+  if (!col || col->type() != cache::ColumnType::Int64) return nullptr;
+  return std::make_unique<index::TimeIndex>(col->ints(), col->valid_bits(),
+                                            store.rows());
+}
+
+}  // namespace
+
+LiveStore::LiveStore(Options opts)
+    : opts_(std::move(opts)),
+      base_(cache::open_or_build(opts_.jsonl_path, opts_.cache_path)) {
+  base_tindex_ = build_time_index(base_, opts_.time_column);
+  // Reattach segments sealed by a previous run of this process
+  // generation; a gap ends the chain.
+  for (;;) {
+    try {
+      segments_.push_back(
+          std::make_unique<cache::ColumnStore>(segment_path(next_segment_)));
+      segment_tindex_.push_back(
+          build_time_index(*segments_.back(), opts_.time_column));
+      ++next_segment_;
+    } catch (const std::exception&) {
+      break;
+    }
+  }
+  if (!opts_.wal_path.empty()) {
+    journal_ = std::make_unique<wal::Journal>(
+        wal::JournalOptions{.path = opts_.wal_path});
+    // Replay what the last run's delta held when it went down; records
+    // sealed before the crash reset the journal, so this is just the tail.
+    journal_->replay([this](std::string_view rec, std::uint64_t off) {
+      append_locked(rec, off);
+    });
+    if (delta_.size() >= opts_.compact_threshold) compact_locked();
+  }
+}
+
+std::string LiveStore::segment_path(std::size_t n) const {
+  return opts_.cache_path + ".seg" + std::to_string(n);
+}
+
+void LiveStore::append_locked(std::string_view record, std::uint64_t offset) {
+  // Copy the line first: parsed string_views then point into the arena,
+  // not into the Follower's transient tail mapping.
+  const std::string_view stable = delta_arena_.copy(record);
+  static thread_local jsonl::Record scratch;
+  if (!parse_record(stable, scratch)) return;
+
+  const auto n = static_cast<std::uint32_t>(scratch.fields.size());
+  jsonl::Field* fields = delta_arena_.alloc_array<jsonl::Field>(n);
+  std::copy(scratch.fields.begin(), scratch.fields.end(), fields);
+  const jsonl::RecordView view{fields, n};
+  delta_.push_back({stable, view, offset});
+  if (const jsonl::Value* id = view.find("id");
+      id != nullptr && id->type == jsonl::ValueType::String)
+    delta_ids_.insert(id->s, offset);
+}
+
+void LiveStore::append(std::string_view record, std::uint64_t offset) {
+  std::unique_lock<std::mutex> lock(mu_);
+  rethrow_compact_error_locked();
+  if (journal_ != nullptr) journal_->append(record, offset);
+  append_locked(record, offset);
+
+  if (delta_.size() < opts_.compact_threshold) return;
+  if (opts_.pool != nullptr) {
+    if (compact_scheduled_) return;
+    compact_scheduled_ = true;
+    opts_.pool->submit([this] {
+      // Seal under the lock, build and write the segment without it,
+      // then relock to install. Appends, finds and queries keep running
+      // for the duration of the segment write — the sealed rows stay
+      // visible through `sealing_` until the segment takes over. A
+      // delta sealed by an earlier failed attempt is retried first.
+      SealedDelta* sealed;
+      {
+        std::unique_lock<std::mutex> relock(mu_);
+        sealed = sealing_ != nullptr ? sealing_.get() : seal_delta_locked();
+        if (sealed == nullptr) {
+          compact_scheduled_ = false;
+          return;
+        }
+      }
+      const std::string path = segment_path(sealed->segment);
+      try {
+        build_segment(*sealed, path);
+        std::unique_lock<std::mutex> relock(mu_);
+        install_segment_locked(path);
+        compact_scheduled_ = false;
+      } catch (...) {
+        // No caller to throw to on a pool worker; latch for the next
+        // append()/compact(). The sealed delta stays in `sealing_`, so
+        // its rows remain queryable and the write retries later.
+        std::unique_lock<std::mutex> relock(mu_);
+        if (compact_error_ == nullptr)
+          compact_error_ = std::current_exception();
+        compact_scheduled_ = false;
+      }
+    });
+  } else {
+    compact_locked();
+  }
+}
+
+std::optional<std::uint64_t> LiveStore::find(std::string_view id) const {
+  std::unique_lock<std::mutex> lock(mu_);
+  if (auto hit = delta_ids_.find(id)) return hit;
+  if (sealing_ != nullptr)
+    if (auto hit = sealing_->ids.find(id)) return hit;
+  for (auto it = segments_.rbegin(); it != segments_.rend(); ++it)
+    if (auto idx = (*it)->id_index())
+      if (auto hit = idx->find(id)) return hit;
+  if (auto idx = base_.id_index())
+    if (auto hit = idx->find(id)) return hit;
+  return std::nullopt;
+}
+
+query::Result LiveStore::run(const query::Query& q) const {
+  std::unique_lock<std::mutex> lock(mu_);
+  std::map<std::string, MergedGroup> merged;
+  query::Result out;
+
+  auto fold_result = [&](const query::Result& r) {
+    out.rows_scanned += r.rows_scanned;
+    out.rows_selected += r.rows_selected;
+    out.rows_pruned += r.rows_pruned;
+    for (const query::GroupResult& g : r.groups)
+      merge_value(q.agg, g.value, merged[g.key]);
+  };
+  auto run_store = [&](const cache::ColumnStore& store,
+                       const index::TimeIndex* tindex) {
+    query::Engine engine(store);
+    if (tindex != nullptr)
+      engine.attach_time_index(opts_.time_column, tindex);
+    fold_result(engine.run(q));
+  };
+
+  // Segments seal in arrival order, so each is a time bucket; a window
+  // query prunes out-of-range segments to zero scanned rows up front.
+  run_store(base_, base_tindex_.get());
+  for (std::size_t i = 0; i < segments_.size(); ++i)
+    run_store(*segments_[i], segment_tindex_[i].get());
+
+  // Delta rows (and any delta mid-seal), row at a time.
+  auto run_delta = [&](const std::vector<DeltaRecord>& records) {
+    for (const DeltaRecord& rec : records) {
+      ++out.rows_scanned;
+      if (!matches(q, rec.view)) continue;
+      std::string key;
+      if (!q.group_by.empty()) {
+        const jsonl::Value* g = rec.view.find(q.group_by);
+        if (g == nullptr || g->type != jsonl::ValueType::String) continue;
+        key = std::string(g->s);
+      }
+      std::int64_t v = 1;
+      if (q.agg != query::AggOp::Count) {
+        const jsonl::Value* a = rec.view.find(q.agg_column);
+        if (a == nullptr || a->type != jsonl::ValueType::Int) continue;
+        v = a->i;
+      }
+      ++out.rows_selected;
+      MergedGroup& g = merged[key];
+      if (q.agg == query::AggOp::Count)
+        merge_value(q.agg, 1, g);
+      else
+        merge_value(q.agg, v, g);
+    }
+  };
+  if (sealing_ != nullptr) run_delta(sealing_->records);
+  run_delta(delta_);
+
+  for (auto& [key, g] : merged)
+    if (g.seen) out.groups.push_back({key, g.value});
+  std::sort(out.groups.begin(), out.groups.end(),
+            [](const query::GroupResult& a, const query::GroupResult& b) {
+              return a.value != b.value ? a.value > b.value : a.key < b.key;
+            });
+  return out;
+}
+
+void LiveStore::compact() {
+  std::unique_lock<std::mutex> lock(mu_);
+  rethrow_compact_error_locked();
+  compact_locked();
+}
+
+void LiveStore::compact_locked() {
+  // A background build may be in flight; it installs on its own.
+  if (compact_scheduled_) return;
+  // Retry a delta sealed by a failed earlier attempt before sealing more.
+  SealedDelta* sealed =
+      sealing_ != nullptr ? sealing_.get() : seal_delta_locked();
+  if (sealed == nullptr) return;
+  const std::string path = segment_path(sealed->segment);
+  build_segment(*sealed, path);
+  install_segment_locked(path);
+}
+
+void LiveStore::rethrow_compact_error_locked() {
+  if (compact_error_ == nullptr) return;
+  std::exception_ptr error = std::exchange(compact_error_, nullptr);
+  std::rethrow_exception(error);
+}
+
+LiveStore::SealedDelta* LiveStore::seal_delta_locked() {
+  if (delta_.empty() || sealing_ != nullptr) return nullptr;
+  auto sealed = std::make_unique<SealedDelta>();
+  sealed->arena = std::move(delta_arena_);
+  sealed->records = std::move(delta_);
+  sealed->ids = std::move(delta_ids_);
+  sealed->segment = next_segment_++;
+  // Moved-from containers are only guaranteed valid; start the new delta
+  // from freshly constructed state.
+  delta_arena_ = mem::Arena();
+  delta_.clear();
+  delta_ids_ = index::IdMap();
+  sealing_ = std::move(sealed);
+  return sealing_.get();
+}
+
+void LiveStore::build_segment(const SealedDelta& sealed,
+                              const std::string& path) const {
+  cache::ColumnStoreBuilder builder;
+  for (const DeltaRecord& rec : sealed.records) builder.add(rec.view);
+  builder.set_id_index(sealed.ids);
+  builder.write(path, 0, 0);
+}
+
+void LiveStore::install_segment_locked(const std::string& path) {
+  segments_.push_back(std::make_unique<cache::ColumnStore>(path));
+  segment_tindex_.push_back(
+      build_time_index(*segments_.back(), opts_.time_column));
+  sealing_.reset();
+  // The sealed segment is durable; the journal entries it covers are not
+  // needed again. A crash before this line replays them into the delta
+  // once more, which the next compaction folds away. Records appended
+  // while the segment was building are still delta-only, so re-log them
+  // into the fresh journal.
+  if (journal_ != nullptr) {
+    journal_->reset();
+    for (const DeltaRecord& rec : delta_) journal_->append(rec.raw, rec.offset);
+  }
+}
+
+std::uint64_t LiveStore::base_rows() const { return base_.rows(); }
+
+std::uint64_t LiveStore::delta_rows() const {
+  std::unique_lock<std::mutex> lock(mu_);
+  return delta_.size();
+}
+
+std::size_t LiveStore::segment_count() const {
+  std::unique_lock<std::mutex> lock(mu_);
+  return segments_.size();
+}
+
+}  // namespace exynos::ingest
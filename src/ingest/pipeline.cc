@@ -0,0 +1,208 @@
+#include "exynos/ingest/pipeline.h"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <optional>
+#include <thread>
+
+#include "exynos/queue/mpsc_ring.h"
+#include "exynos/sched/steal_pool.h"
+#include "exynos/trace/trace.h"
+
+namespace exynos::ingest {
+
+namespace {
+
+// Core classification by cpufreq ceiling: the cluster(s) with the highest
+// cpuinfo_max_freq are "big" (Cortex-X/A7xx on our parts), everything else
+// is "little". Homogeneous machines yield an empty split and we skip
+// pinning entirely.
+struct CoreSets {
+  std::vector<int> big;
+  std::vector<int> little;
+};
+
+long read_max_freq(int cpu) {
+  char path[128];
+  std::snprintf(path, sizeof(path),
+                "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+  std::FILE* f = std::fopen(path, "r");
+  if (f == nullptr) return -1;
+  long khz = -1;
+  if (std::fscanf(f, "%ld", &khz) != 1) khz = -1;
+  std::fclose(f);
+  return khz;
+}
+
+CoreSets classify_cores() {
+  CoreSets sets;
+  const int ncpu = static_cast<int>(std::thread::hardware_concurrency());
+  long best = -1;
+  std::vector<long> freqs(static_cast<std::size_t>(ncpu), -1);
+  for (int cpu = 0; cpu < ncpu; ++cpu) {
+    freqs[static_cast<std::size_t>(cpu)] = read_max_freq(cpu);
+    if (freqs[static_cast<std::size_t>(cpu)] > best)
+      best = freqs[static_cast<std::size_t>(cpu)];
+  }
+  if (best < 0) return sets;  // no cpufreq (VMs, containers)
+  for (int cpu = 0; cpu < ncpu; ++cpu) {
+    if (freqs[static_cast<std::size_t>(cpu)] == best)
+      sets.big.push_back(cpu);
+    else if (freqs[static_cast<std::size_t>(cpu)] > 0)
+      sets.little.push_back(cpu);
+  }
+  if (sets.little.empty()) sets.big.clear();  // homogeneous: don't pin
+  return sets;
+}
+
+// Pins the calling thread for one scope, restoring the original mask on
+// the way out so the placement does not leak onto whatever the caller
+// runs on this thread afterwards.
+class AffinityScope {
+ public:
+  explicit AffinityScope(const std::vector<int>& cpus) {
+    if (cpus.empty()) return;
+    restore_ = ::sched_getaffinity(0, sizeof(saved_), &saved_) == 0;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) CPU_SET(cpu, &set);
+    // Best effort: failure (cgroup restrictions, masked cores) just loses
+    // the placement win, never correctness.
+    (void)::sched_setaffinity(0, sizeof(set), &set);
+  }
+  ~AffinityScope() {
+    if (restore_) (void)::sched_setaffinity(0, sizeof(saved_), &saved_);
+  }
+
+  AffinityScope(const AffinityScope&) = delete;
+  AffinityScope& operator=(const AffinityScope&) = delete;
+
+ private:
+  cpu_set_t saved_;
+  bool restore_ = false;
+};
+
+}  // namespace
+
+Pipeline::Pipeline(PipelineOptions opts) : opts_(opts) {}
+
+std::vector<std::string_view> Pipeline::split_chunks(std::string_view data,
+                                                     std::size_t chunk_bytes) {
+  std::vector<std::string_view> chunks;
+  if (chunk_bytes == 0) chunk_bytes = 1;
+  std::size_t begin = 0;
+  while (begin < data.size()) {
+    std::size_t end = begin + chunk_bytes;
+    if (end >= data.size()) {
+      end = data.size();
+    } else {
+      // Advance to the next record boundary so no record straddles chunks.
+      std::size_t nl = data.find('\n', end);
+      end = nl == std::string_view::npos ? data.size() : nl + 1;
+    }
+    chunks.push_back(data.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+void Pipeline::run(std::string_view data, const Consumer& consume) {
+  const std::vector<std::string_view> chunks =
+      split_chunks(data, opts_.chunk_bytes);
+  if (chunks.empty()) return;
+
+  const CoreSets cores = opts_.pin_cores ? classify_cores() : CoreSets{};
+
+  unsigned workers = opts_.workers;
+  if (workers == 0) {
+    unsigned hw = std::thread::hardware_concurrency();
+    workers = hw > 1 ? hw - 1 : 1;
+  }
+  if (workers > chunks.size()) workers = static_cast<unsigned>(chunks.size());
+
+  // Lock-free handoff to the merge stage; sized past the worker count so
+  // producers only back off when the merge thread genuinely falls behind.
+  queue::MpscRing<ParsedChunk> ring(workers * 4 + 8);
+
+  auto parse_one = [&](std::size_t i) {
+    EXYNOS_TRACE_SCOPE("pipeline.parse_chunk");
+    // Parse scratch reused across every record this worker touches; its
+    // capacity stabilizes after a few records, so the steady-state hot
+    // path performs no heap allocation at all.
+    static thread_local jsonl::Record scratch;
+    ParsedChunk chunk;
+    chunk.index = i;
+    chunk.begin_offset =
+        static_cast<std::size_t>(chunks[i].data() - data.data());
+    std::size_t pos = 0;
+    const std::string_view body = chunks[i];
+    while (pos < body.size()) {
+      std::size_t nl = body.find('\n', pos);
+      std::string_view line = body.substr(
+          pos, nl == std::string_view::npos ? body.size() - pos : nl - pos);
+      pos = nl == std::string_view::npos ? body.size() : nl + 1;
+      if (line.empty()) continue;
+      if (parse_record(line, scratch)) {
+        const auto n = static_cast<std::uint32_t>(scratch.fields.size());
+        jsonl::Field* fields = chunk.arena.alloc_array<jsonl::Field>(n);
+        std::copy(scratch.fields.begin(), scratch.fields.end(), fields);
+        chunk.records.push_back({fields, n});
+      } else {
+        ++chunk.malformed;
+      }
+    }
+    EXYNOS_TRACE_COUNTER(push_retries, "pipeline.ring_push_retries");
+    while (!ring.try_push(std::move(chunk))) {
+      push_retries.add();
+      std::this_thread::yield();
+    }
+  };
+
+  // Chunk parsing runs on the work-stealing pool: the weighted deques
+  // start big cores with more chunks and stealing mops up stragglers.
+  // With several DSU clusters, contiguous chunk runs stripe over them —
+  // a chunk's parse and arena writes then stay behind one L3 slice, and
+  // the pool's cluster-first stealing keeps them there under imbalance.
+  sched::StealPool pool(workers);
+  const unsigned nclusters =
+      opts_.cluster_local ? pool.cluster_count() : 1;
+  for (std::size_t i = 0; i < chunks.size(); ++i) {
+    if (nclusters > 1)
+      pool.submit_on_cluster(
+          static_cast<unsigned>(i * nclusters / chunks.size()),
+          [&parse_one, i] { parse_one(i); });
+    else
+      pool.submit([&parse_one, i] { parse_one(i); });
+  }
+
+  // Merge stage: drain the ring in batches and re-sequence into strict
+  // file order before invoking the consumer. The pin lasts only for the
+  // merge; run() returns with the caller's original mask intact.
+  AffinityScope merge_pin(cores.big);
+  std::vector<std::optional<ParsedChunk>> pending(chunks.size());
+  std::vector<ParsedChunk> batch;
+  std::size_t next_emit = 0;
+  while (next_emit < chunks.size()) {
+    batch.clear();
+    if (ring.pop_batch(batch, 64) == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (ParsedChunk& chunk : batch)
+      pending[chunk.index] = std::move(chunk);
+    while (next_emit < chunks.size() && pending[next_emit].has_value()) {
+      EXYNOS_TRACE_SCOPE("pipeline.merge_consume");
+      ParsedChunk chunk = std::move(*pending[next_emit]);
+      pending[next_emit].reset();
+      ++next_emit;
+      consume(std::move(chunk));
+    }
+  }
+
+  pool.wait_idle();
+}
+
+}  // namespace exynos::ingest
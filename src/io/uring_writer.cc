@@ -0,0 +1,277 @@
+#include "exynos/io/uring_writer.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include "exynos/trace/trace.h"
+
+namespace exynos::io {
+
+namespace {
+
+// liburing is not a dependency; the three syscalls are stable ABI.
+int sys_io_uring_setup(unsigned entries, io_uring_params* p) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                       unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int sys_io_uring_register(int fd, unsigned opcode, const void* arg,
+                          unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+std::atomic<unsigned>* at(void* base, std::uint32_t off) {
+  return reinterpret_cast<std::atomic<unsigned>*>(
+      static_cast<char*>(base) + off);
+}
+
+}  // namespace
+
+struct UringWriter::Ring {
+  void* sq_map = MAP_FAILED;
+  std::size_t sq_map_len = 0;
+  void* cq_map = MAP_FAILED;  // == sq_map under IORING_FEAT_SINGLE_MMAP
+  std::size_t cq_map_len = 0;
+  io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  std::size_t sqes_len = 0;
+
+  std::atomic<unsigned>* sq_tail;
+  unsigned sq_mask;
+  unsigned* sq_array;
+  std::atomic<unsigned>* cq_head;
+  std::atomic<unsigned>* cq_tail;
+  unsigned cq_mask;
+  io_uring_cqe* cqes;
+
+  // One registration-backed buffer per queue slot; slot i owns
+  // buffers + i * buffer_bytes.
+  std::vector<char> buffers;
+};
+
+UringWriter::UringWriter(const std::string& path, Options opts)
+    : path_(path) {
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0)
+    throw std::system_error(errno, std::generic_category(), "open " + path);
+  if (opts.queue_depth == 0) opts.queue_depth = 1;
+  buffer_bytes_ = opts.buffer_bytes != 0 ? opts.buffer_bytes : 4096;
+  setup_ring(opts.queue_depth, buffer_bytes_);
+}
+
+UringWriter::~UringWriter() {
+  try {
+    close();
+  } catch (const std::exception&) {
+    // Destructor path: the damage is already recorded in errno terms and
+    // the caller chose not to flush explicitly.
+  }
+}
+
+void UringWriter::setup_ring(unsigned depth, std::size_t buffer_bytes) {
+  io_uring_params params{};
+  ring_fd_ = sys_io_uring_setup(depth, &params);
+  if (ring_fd_ < 0) return;  // ENOSYS / seccomp: pwrite path
+  // SINGLE_MMAP shipped in 5.4; both fleet kernels (5.15, 6.x) have it,
+  // so anything older takes the fallback rather than a third mapping
+  // scheme.
+  if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+    return;
+  }
+
+  auto* r = new Ring();
+  ring_ = r;
+  r->sq_map_len = std::max<std::size_t>(
+      params.sq_off.array + params.sq_entries * sizeof(unsigned),
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  r->sq_map = ::mmap(nullptr, r->sq_map_len, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  r->cq_map = r->sq_map;
+  r->cq_map_len = r->sq_map_len;
+  r->sqes_len = params.sq_entries * sizeof(io_uring_sqe);
+  r->sqes = static_cast<io_uring_sqe*>(
+      ::mmap(nullptr, r->sqes_len, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+  if (r->sq_map == MAP_FAILED || r->sqes == static_cast<void*>(MAP_FAILED)) {
+    teardown_ring();
+    return;
+  }
+
+  r->sq_tail = at(r->sq_map, params.sq_off.tail);
+  r->sq_mask = *reinterpret_cast<unsigned*>(
+      static_cast<char*>(r->sq_map) + params.sq_off.ring_mask);
+  r->sq_array = reinterpret_cast<unsigned*>(
+      static_cast<char*>(r->sq_map) + params.sq_off.array);
+  r->cq_head = at(r->cq_map, params.cq_off.head);
+  r->cq_tail = at(r->cq_map, params.cq_off.tail);
+  r->cq_mask = *reinterpret_cast<unsigned*>(
+      static_cast<char*>(r->cq_map) + params.cq_off.ring_mask);
+  r->cqes = reinterpret_cast<io_uring_cqe*>(
+      static_cast<char*>(r->cq_map) + params.cq_off.cqes);
+
+  r->buffers.resize(static_cast<std::size_t>(depth) * buffer_bytes);
+  std::vector<iovec> iovs(depth);
+  for (unsigned i = 0; i < depth; ++i) {
+    iovs[i].iov_base = r->buffers.data() + i * buffer_bytes;
+    iovs[i].iov_len = buffer_bytes;
+  }
+  if (sys_io_uring_register(ring_fd_, IORING_REGISTER_BUFFERS, iovs.data(),
+                            depth) < 0) {
+    // RLIMIT_MEMLOCK too low, most likely. Fixed buffers are the point
+    // of this writer, so degrade all the way rather than half-async.
+    teardown_ring();
+    return;
+  }
+  free_bufs_.reserve(depth);
+  for (unsigned i = 0; i < depth; ++i) free_bufs_.push_back(i);
+  submitted_len_.assign(depth, 0);
+}
+
+void UringWriter::teardown_ring() {
+  if (ring_ != nullptr) {
+    if (ring_->sq_map != MAP_FAILED)
+      ::munmap(ring_->sq_map, ring_->sq_map_len);
+    if (ring_->sqes != static_cast<void*>(MAP_FAILED))
+      ::munmap(ring_->sqes, ring_->sqes_len);
+    delete ring_;
+    ring_ = nullptr;
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  free_bufs_.clear();
+  submitted_len_.clear();
+}
+
+void UringWriter::submit(unsigned buf_index, std::uint64_t offset,
+                         std::size_t len) {
+  Ring& r = *ring_;
+  const unsigned tail = r.sq_tail->load(std::memory_order_relaxed);
+  const unsigned idx = tail & r.sq_mask;
+  io_uring_sqe& sqe = r.sqes[idx];
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = IORING_OP_WRITE_FIXED;
+  sqe.fd = fd_;
+  sqe.addr = reinterpret_cast<std::uint64_t>(r.buffers.data() +
+                                             buf_index * buffer_bytes_);
+  sqe.len = static_cast<std::uint32_t>(len);
+  sqe.off = offset;
+  sqe.buf_index = static_cast<std::uint16_t>(buf_index);
+  sqe.user_data = buf_index;
+  submitted_len_[buf_index] = len;
+  r.sq_array[idx] = idx;
+  r.sq_tail->store(tail + 1, std::memory_order_release);
+  ++inflight_;
+  // EINTR just means a signal landed mid-call; the sqe is still queued
+  // (or already consumed, making the retry a no-op), not failed.
+  int rc;
+  do {
+    rc = sys_io_uring_enter(ring_fd_, 1, 0, 0);
+  } while (rc < 0 && errno == EINTR);
+  if (rc < 0 && deferred_errno_ == 0) deferred_errno_ = errno;
+}
+
+void UringWriter::reap(bool wait) {
+  Ring& r = *ring_;
+  if (wait && r.cq_head->load(std::memory_order_relaxed) ==
+                  r.cq_tail->load(std::memory_order_acquire)) {
+    EXYNOS_TRACE_SCOPE("uring_writer.reap_wait");
+    // A signal can interrupt the blocking wait; that says nothing about
+    // the writes, so retry rather than latching a spurious error.
+    int rc;
+    do {
+      rc = sys_io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+    } while (rc < 0 && errno == EINTR);
+    if (rc < 0 && deferred_errno_ == 0) deferred_errno_ = errno;
+  }
+  unsigned head = r.cq_head->load(std::memory_order_relaxed);
+  while (head != r.cq_tail->load(std::memory_order_acquire)) {
+    const io_uring_cqe& cqe = r.cqes[head & r.cq_mask];
+    const auto buf = static_cast<unsigned>(cqe.user_data);
+    if (cqe.res < 0) {
+      if (deferred_errno_ == 0) deferred_errno_ = -cqe.res;
+    } else if (static_cast<std::size_t>(cqe.res) != submitted_len_[buf]) {
+      // A short write leaves a hole the caller already accounted for;
+      // the buffer slot is recycled by then, so treat it as an I/O
+      // error rather than papering over it (pwrite fallback loops
+      // instead, but O_WRONLY regular files should never write short).
+      if (deferred_errno_ == 0) deferred_errno_ = EIO;
+    }
+    free_bufs_.push_back(buf);
+    --inflight_;
+    ++head;
+  }
+  r.cq_head->store(head, std::memory_order_release);
+}
+
+void UringWriter::write_at(std::uint64_t offset, const void* data,
+                           std::size_t len) {
+  const char* src = static_cast<const char*>(data);
+  if (ring_fd_ < 0) {
+    while (len != 0) {
+      const ssize_t n = ::pwrite(fd_, src, len, static_cast<off_t>(offset));
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        throw std::system_error(errno, std::generic_category(),
+                                "pwrite " + path_);
+      }
+      src += n;
+      offset += static_cast<std::uint64_t>(n);
+      len -= static_cast<std::size_t>(n);
+      bytes_written_ += static_cast<std::uint64_t>(n);
+    }
+    return;
+  }
+  while (len != 0) {
+    reap(/*wait=*/free_bufs_.empty());
+    if (free_bufs_.empty()) continue;
+    const unsigned buf = free_bufs_.back();
+    free_bufs_.pop_back();
+    const std::size_t chunk = std::min(len, buffer_bytes_);
+    std::memcpy(ring_->buffers.data() + buf * buffer_bytes_, src, chunk);
+    submit(buf, offset, chunk);
+    src += chunk;
+    offset += chunk;
+    len -= chunk;
+    bytes_written_ += chunk;
+  }
+}
+
+void UringWriter::flush() {
+  EXYNOS_TRACE_SCOPE("uring_writer.flush");
+  while (ring_fd_ >= 0 && inflight_ != 0) reap(/*wait=*/true);
+  if (deferred_errno_ != 0) {
+    const int err = deferred_errno_;
+    deferred_errno_ = 0;
+    throw std::system_error(err, std::generic_category(), "write " + path_);
+  }
+}
+
+void UringWriter::close() {
+  if (fd_ < 0) return;
+  flush();
+  teardown_ring();
+  const int fd = fd_;
+  fd_ = -1;
+  if (::close(fd) != 0)
+    throw std::system_error(errno, std::generic_category(), "close " + path_);
+}
+
+}  // namespace exynos::io
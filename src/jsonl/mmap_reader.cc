@@ -0,0 +1,96 @@
+#include "exynos/jsonl/mmap_reader.h"
+
+#include "exynos/trace/trace.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+namespace exynos::jsonl {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace
+
+MmapReader::MmapReader(const std::string& path) {
+  EXYNOS_TRACE_SCOPE("mmap_reader.map");
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) throw_errno("open " + path);
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    int saved = errno;
+    ::close(fd);
+    errno = saved;
+    throw_errno("fstat " + path);
+  }
+  mtime_ns_ = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 +
+              st.st_mtim.tv_nsec;
+  size_ = static_cast<std::size_t>(st.st_size);
+
+  if (size_ == 0) {
+    // mmap(2) rejects zero-length mappings; an empty file is a valid
+    // (empty) record stream.
+    ::close(fd);
+    data_ = nullptr;
+    return;
+  }
+
+  void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  int saved = errno;
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    errno = saved;
+    throw_errno("mmap " + path);
+  }
+  // Startup replay walks the file front to back; tell the kernel so it
+  // reads ahead aggressively and drops pages behind us.
+  ::madvise(map, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(map);
+}
+
+MmapReader::~MmapReader() {
+  if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+}
+
+MmapReader::MmapReader(MmapReader&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mtime_ns_(other.mtime_ns_) {}
+
+MmapReader& MmapReader::operator=(MmapReader&& other) noexcept {
+  if (this != &other) {
+    if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mtime_ns_ = other.mtime_ns_;
+  }
+  return *this;
+}
+
+void MmapReader::Iterator::advance() {
+  record_ = {};
+  while (pos_ != end_) {
+    const char* nl = static_cast<const char*>(
+        memchr(pos_, '\n', static_cast<std::size_t>(end_ - pos_)));
+    const char* rec_end = nl != nullptr ? nl : end_;
+    std::string_view rec(pos_, static_cast<std::size_t>(rec_end - pos_));
+    pos_ = nl != nullptr ? nl + 1 : end_;
+    if (!rec.empty()) {
+      record_ = rec;
+      return;
+    }
+  }
+}
+
+}  // namespace exynos::jsonl
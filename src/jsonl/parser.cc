@@ -0,0 +1,172 @@
+#include "exynos/jsonl/parser.h"
+
+#include <cstdlib>
+
+namespace exynos::jsonl {
+
+namespace {
+
+struct Cursor {
+  const char* p;
+  const char* end;
+
+  bool done() const { return p == end; }
+  char peek() const { return *p; }
+
+  void skip_ws() {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+  }
+
+  bool consume(char c) {
+    if (p != end && *p == c) {
+      ++p;
+      return true;
+    }
+    return false;
+  }
+};
+
+// Scans past a string literal; `out` receives the escaped contents between
+// the quotes. Assumes the opening quote is already consumed.
+bool scan_string(Cursor& c, std::string_view& out) {
+  const char* start = c.p;
+  while (c.p != c.end) {
+    if (*c.p == '\\') {
+      c.p += 2 <= c.end - c.p ? 2 : 1;
+      continue;
+    }
+    if (*c.p == '"') {
+      out = {start, static_cast<std::size_t>(c.p - start)};
+      ++c.p;
+      return true;
+    }
+    ++c.p;
+  }
+  return false;
+}
+
+// Scans past a balanced {...} or [...] and records the raw slice.
+bool scan_raw(Cursor& c, std::string_view& out) {
+  const char* start = c.p;
+  int depth = 0;
+  while (c.p != c.end) {
+    char ch = *c.p;
+    if (ch == '"') {
+      ++c.p;
+      std::string_view ignored;
+      if (!scan_string(c, ignored)) return false;
+      continue;
+    }
+    if (ch == '{' || ch == '[') ++depth;
+    if (ch == '}' || ch == ']') {
+      --depth;
+      if (depth == 0) {
+        ++c.p;
+        out = {start, static_cast<std::size_t>(c.p - start)};
+        return true;
+      }
+    }
+    ++c.p;
+  }
+  return false;
+}
+
+bool parse_number(Cursor& c, Value& v) {
+  const char* start = c.p;
+  bool is_double = false;
+  if (c.p != c.end && (*c.p == '-' || *c.p == '+')) ++c.p;
+  while (c.p != c.end) {
+    char ch = *c.p;
+    if (ch >= '0' && ch <= '9') {
+      ++c.p;
+    } else if (ch == '.' || ch == 'e' || ch == 'E' || ch == '-' || ch == '+') {
+      is_double = true;
+      ++c.p;
+    } else {
+      break;
+    }
+  }
+  if (c.p == start) return false;
+  // Numbers sit inside a line of a larger mapping, so they are not
+  // NUL-terminated; the slice is short enough that a bounded copy is free.
+  char buf[32];
+  std::size_t len = static_cast<std::size_t>(c.p - start);
+  if (len >= sizeof(buf)) return false;
+  __builtin_memcpy(buf, start, len);
+  buf[len] = '\0';
+  if (is_double) {
+    v.type = ValueType::Double;
+    v.d = std::strtod(buf, nullptr);
+  } else {
+    v.type = ValueType::Int;
+    v.i = std::strtoll(buf, nullptr, 10);
+  }
+  return true;
+}
+
+bool match_literal(Cursor& c, std::string_view lit) {
+  if (static_cast<std::size_t>(c.end - c.p) < lit.size()) return false;
+  if (std::string_view(c.p, lit.size()) != lit) return false;
+  c.p += lit.size();
+  return true;
+}
+
+bool parse_value(Cursor& c, Value& v) {
+  c.skip_ws();
+  if (c.done()) return false;
+  char ch = c.peek();
+  if (ch == '"') {
+    ++c.p;
+    v.type = ValueType::String;
+    return scan_string(c, v.s);
+  }
+  if (ch == '{' || ch == '[') {
+    v.type = ValueType::Raw;
+    return scan_raw(c, v.s);
+  }
+  if (ch == 't') {
+    if (!match_literal(c, "true")) return false;
+    v.type = ValueType::Bool;
+    v.b = true;
+    return true;
+  }
+  if (ch == 'f') {
+    if (!match_literal(c, "false")) return false;
+    v.type = ValueType::Bool;
+    v.b = false;
+    return true;
+  }
+  if (ch == 'n') {
+    if (!match_literal(c, "null")) return false;
+    v.type = ValueType::Null;
+    return true;
+  }
+  return parse_number(c, v);
+}
+
+}  // namespace
+
+bool parse_record(std::string_view json, Record& out) {
+  out.clear();
+  Cursor c{json.data(), json.data() + json.size()};
+  c.skip_ws();
+  if (!c.consume('{')) return false;
+  c.skip_ws();
+  if (c.consume('}')) return true;
+  for (;;) {
+    c.skip_ws();
+    if (!c.consume('"')) return false;
+    Field f;
+    if (!scan_string(c, f.key)) return false;
+    c.skip_ws();
+    if (!c.consume(':')) return false;
+    if (!parse_value(c, f.value)) return false;
+    out.fields.push_back(f);
+    c.skip_ws();
+    if (c.consume(',')) continue;
+    if (c.consume('}')) return true;
+    return false;
+  }
+}
+
+}  // namespace exynos::jsonl
@@ -0,0 +1,184 @@
+#include "exynos/jsonl/simd_text.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "exynos/jsonl/simd_scanner.h"
+
+namespace exynos::jsonl {
+
+namespace {
+
+constexpr std::size_t kBlock = 64;
+
+// All 64 bytes < 0x80? One reduction per block.
+inline bool block_is_ascii(const char* p) {
+#if defined(__ARM_NEON)
+  uint8x16_t acc = vld1q_u8(reinterpret_cast<const std::uint8_t*>(p));
+  for (int v = 1; v < 4; ++v)
+    acc = vorrq_u8(acc,
+                   vld1q_u8(reinterpret_cast<const std::uint8_t*>(p) + v * 16));
+  return vmaxvq_u8(acc) < 0x80;
+#else
+  std::uint64_t acc = 0;
+  for (int w = 0; w < 8; ++w) {
+    std::uint64_t word;
+    std::memcpy(&word, p + w * 8, 8);
+    acc |= word;
+  }
+  return (acc & 0x8080808080808080ULL) == 0;
+#endif
+}
+
+// Scalar validation of one multibyte sequence starting at p[0] >= 0x80.
+// Returns the sequence length, or 0 when malformed (overlong encodings,
+// surrogates, > U+10FFFF, truncation).
+inline std::size_t validate_multibyte(const unsigned char* p,
+                                      std::size_t left) {
+  const unsigned char b0 = p[0];
+  auto cont = [&](std::size_t i) { return (p[i] & 0xC0) == 0x80; };
+  if (b0 < 0xC2) return 0;  // stray continuation or overlong 2-byte
+  if (b0 <= 0xDF) return left >= 2 && cont(1) ? 2 : 0;
+  if (b0 <= 0xEF) {
+    if (left < 3 || !cont(1) || !cont(2)) return 0;
+    if (b0 == 0xE0 && p[1] < 0xA0) return 0;  // overlong 3-byte
+    if (b0 == 0xED && p[1] > 0x9F) return 0;  // UTF-16 surrogate range
+    return 3;
+  }
+  if (b0 <= 0xF4) {
+    if (left < 4 || !cont(1) || !cont(2) || !cont(3)) return 0;
+    if (b0 == 0xF0 && p[1] < 0x90) return 0;  // overlong 4-byte
+    if (b0 == 0xF4 && p[1] > 0x8F) return 0;  // past U+10FFFF
+    return 4;
+  }
+  return 0;
+}
+
+inline int hex_digit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Parses the XXXX of a \uXXXX escape; -1 on a bad digit.
+inline int parse_hex4(const char* p) {
+  int v = 0;
+  for (int i = 0; i < 4; ++i) {
+    const int d = hex_digit(p[i]);
+    if (d < 0) return -1;
+    v = (v << 4) | d;
+  }
+  return v;
+}
+
+inline void append_utf8(std::string& out, std::uint32_t cp) {
+  if (cp < 0x80) {
+    out.push_back(static_cast<char>(cp));
+  } else if (cp < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else if (cp < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+  }
+}
+
+}  // namespace
+
+bool simd_validate_utf8(std::string_view data) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  std::size_t i = 0;
+  const std::size_t n = data.size();
+  while (i < n) {
+    // Fast path: hop whole ASCII blocks. Multibyte sequences are at most
+    // 4 bytes, so a sequence straddling the previous block has already
+    // been consumed past the boundary before we land here.
+    while (n - i >= kBlock &&
+           block_is_ascii(reinterpret_cast<const char*>(p + i)))
+      i += kBlock;
+    if (i >= n) break;
+    if (p[i] < 0x80) {
+      ++i;
+      continue;
+    }
+    const std::size_t len = validate_multibyte(p + i, n - i);
+    if (len == 0) return false;
+    i += len;
+  }
+  return true;
+}
+
+bool simd_unescape(std::string_view in, std::string& out) {
+  out.clear();
+  out.reserve(in.size());
+  const char* p = in.data();
+  std::size_t i = 0;
+  const std::size_t n = in.size();
+  while (i < n) {
+    // Bulk-copy blocks with no backslash; one mask per 64 bytes.
+    while (n - i >= kBlock &&
+           DefaultScanPolicy::eq_mask64(p + i, '\\') == 0) {
+      out.append(p + i, kBlock);
+      i += kBlock;
+    }
+    const char* next = static_cast<const char*>(std::memchr(p + i, '\\', n - i));
+    if (next == nullptr) {
+      out.append(p + i, n - i);
+      return true;
+    }
+    out.append(p + i, static_cast<std::size_t>(next - (p + i)));
+    i = static_cast<std::size_t>(next - p);
+
+    if (i + 1 >= n) return false;  // dangling backslash
+    const char esc = p[i + 1];
+    i += 2;
+    switch (esc) {
+      case '"': out.push_back('"'); break;
+      case '\\': out.push_back('\\'); break;
+      case '/': out.push_back('/'); break;
+      case 'b': out.push_back('\b'); break;
+      case 'f': out.push_back('\f'); break;
+      case 'n': out.push_back('\n'); break;
+      case 'r': out.push_back('\r'); break;
+      case 't': out.push_back('\t'); break;
+      case 'u': {
+        if (i + 4 > n) return false;
+        int cp = parse_hex4(p + i);
+        if (cp < 0) return false;
+        i += 4;
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+          // High surrogate: must pair with \uDC00-\uDFFF.
+          if (i + 6 > n || p[i] != '\\' || p[i + 1] != 'u') return false;
+          const int low = parse_hex4(p + i + 2);
+          if (low < 0xDC00 || low > 0xDFFF) return false;
+          i += 6;
+          append_utf8(out, 0x10000u +
+                               ((static_cast<std::uint32_t>(cp) - 0xD800u)
+                                << 10) +
+                               (static_cast<std::uint32_t>(low) - 0xDC00u));
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+          return false;  // unpaired low surrogate
+        } else {
+          append_utf8(out, static_cast<std::uint32_t>(cp));
+        }
+        break;
+      }
+      default:
+        return false;  // not a JSON escape
+    }
+  }
+  return true;
+}
+
+}  // namespace exynos::jsonl
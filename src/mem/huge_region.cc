@@ -0,0 +1,87 @@
+#include "exynos/mem/huge_region.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "exynos/trace/trace.h"
+
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+
+namespace exynos::mem {
+
+namespace {
+
+constexpr std::size_t kHugePage = 2 * 1024 * 1024;
+
+std::size_t round_up(std::size_t n, std::size_t page) {
+  return (n + page - 1) & ~(page - 1);
+}
+
+}  // namespace
+
+HugeRegion::HugeRegion(std::size_t bytes, Options opts) {
+  if (bytes == 0) bytes = 1;
+
+  // Explicit hugetlb pages first: guaranteed 2 MB TLB reach, but only
+  // when the administrator reserved a pool (vm.nr_hugepages).
+  size_ = round_up(bytes, kHugePage);
+  addr_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (addr_ != MAP_FAILED) {
+    page_size_ = kHugePage;
+    backing_ = Backing::HugeTlb;
+  } else {
+    // Transparent fallback: normal mapping, 2 MB aligned sizing, and
+    // MADV_HUGEPAGE so khugepaged collapses it when THP is enabled.
+    addr_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (addr_ == MAP_FAILED)
+      throw std::system_error(errno, std::generic_category(),
+                              "mmap huge region");
+    page_size_ = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    backing_ = ::madvise(addr_, size_, MADV_HUGEPAGE) == 0
+                   ? Backing::TransparentHuge
+                   : Backing::Small;
+  }
+
+  if (opts.lock) locked_ = ::mlock(addr_, size_) == 0;
+}
+
+HugeRegion::~HugeRegion() {
+  if (addr_ != nullptr) ::munmap(addr_, size_);
+}
+
+HugeRegion::HugeRegion(HugeRegion&& other) noexcept
+    : addr_(std::exchange(other.addr_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      page_size_(other.page_size_),
+      backing_(other.backing_),
+      locked_(other.locked_) {}
+
+std::size_t HugeRegion::resident_bytes() const {
+  const std::size_t small_page =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  // mincore reports in small-page units regardless of backing.
+  std::vector<unsigned char> vec((size_ + small_page - 1) / small_page);
+  std::size_t resident = 0;
+  if (::mincore(addr_, size_, vec.data()) == 0) {
+    for (unsigned char v : vec)
+      if (v & 1) resident += small_page;
+  } else if (backing_ == Backing::HugeTlb) {
+    // Hugetlb pages are populated at fault and never swapped; mincore
+    // support for them is spotty, so count the mapping as resident.
+    resident = size_;
+  }
+  EXYNOS_TRACE_COUNTER(resident_kb, "huge_region.resident_kb");
+  resident_kb.add(resident / 1024);
+  return resident;
+}
+
+}  // namespace exynos::mem
@@ -0,0 +1,113 @@
+#include "exynos/mem/string_pool.h"
+
+#include "exynos/index/id_map.h"
+
+namespace exynos::mem {
+
+namespace {
+constexpr std::size_t kInitialSlots = 64;
+}
+
+StringPool::StringPool() = default;
+
+StringPool::~StringPool() {
+  for (auto& slab : slabs_) delete[] slab.load(std::memory_order_relaxed);
+}
+
+void StringPool::locate(std::uint32_t id, unsigned& slab,
+                        std::uint32_t& off) {
+  // Slab k starts at kBaseSlab * (2^k - 1) and holds kBaseSlab << k
+  // entries; dividing out the base turns that into a log2.
+  const std::uint32_t x = (id >> kBaseSlabBits) + 1;
+  slab = static_cast<unsigned>(31 - __builtin_clz(x));
+  off = id - ((kBaseSlab << slab) - kBaseSlab);
+}
+
+void StringPool::publish(std::uint32_t id, Entry e) {
+  unsigned slab;
+  std::uint32_t off;
+  locate(id, slab, off);
+  Entry* block = slabs_[slab].load(std::memory_order_acquire);
+  if (block == nullptr) {
+    std::lock_guard<std::mutex> lock(slab_mu_);
+    block = slabs_[slab].load(std::memory_order_relaxed);
+    if (block == nullptr) {
+      block = new Entry[kBaseSlab << slab]();
+      slabs_[slab].store(block, std::memory_order_release);
+    }
+  }
+  block[off] = e;
+}
+
+std::string_view StringPool::get(std::uint32_t id) const {
+  unsigned slab;
+  std::uint32_t off;
+  locate(id, slab, off);
+  const Entry& e = slabs_[slab].load(std::memory_order_acquire)[off];
+  return {e.data, e.len};
+}
+
+std::uint32_t StringPool::find_in(const Shard& s, std::uint64_t h,
+                                  std::string_view str) const {
+  if (s.slots.empty()) return kNpos;
+  const std::size_t mask = s.slots.size() - 1;
+  for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+    const Shard::Slot& slot = s.slots[i];
+    if (slot.id == kNpos) return kNpos;
+    if (slot.hash == h && get(slot.id) == str) return slot.id;
+  }
+}
+
+void StringPool::grow(Shard& s) const {
+  std::vector<Shard::Slot> old = std::move(s.slots);
+  s.slots.assign(old.empty() ? kInitialSlots : old.size() * 2,
+                 {0, kNpos});
+  const std::size_t mask = s.slots.size() - 1;
+  for (const Shard::Slot& slot : old) {
+    if (slot.id == kNpos) continue;
+    std::size_t i = slot.hash & mask;
+    while (s.slots[i].id != kNpos) i = (i + 1) & mask;
+    s.slots[i] = slot;
+  }
+}
+
+std::uint32_t StringPool::intern(std::string_view s) {
+  const std::uint64_t h = index::IdMap::hash(s);
+  Shard& shard = shard_for(h);
+  std::lock_guard<std::mutex> lock(shard.mu);
+  if (std::uint32_t id = find_in(shard, h, s); id != kNpos) return id;
+
+  if (shard.slots.empty() || shard.used * 8 >= shard.slots.size() * 7)
+    grow(shard);
+  const std::string_view stored = shard.bytes.copy(s);
+  const std::uint32_t id = next_id_.fetch_add(1, std::memory_order_acq_rel);
+  publish(id, {stored.data(), static_cast<std::uint32_t>(stored.size())});
+  const std::size_t mask = shard.slots.size() - 1;
+  std::size_t i = h & mask;
+  while (shard.slots[i].id != kNpos) i = (i + 1) & mask;
+  shard.slots[i] = {h, id};
+  ++shard.used;
+  return id;
+}
+
+std::uint32_t StringPool::find(std::string_view s) const {
+  const std::uint64_t h = index::IdMap::hash(s);
+  Shard& shard = shard_for(h);
+  std::lock_guard<std::mutex> lock(shard.mu);
+  return find_in(shard, h, s);
+}
+
+std::size_t StringPool::bytes_used() const {
+  std::size_t total = 0;
+  for (const Shard& s : shards_) {
+    std::lock_guard<std::mutex> lock(s.mu);
+    total += s.bytes.bytes_reserved() +
+             s.slots.size() * sizeof(Shard::Slot);
+  }
+  for (unsigned k = 0; k < kMaxSlabs; ++k)
+    if (slabs_[k].load(std::memory_order_relaxed) != nullptr)
+      total += (kBaseSlab << k) * sizeof(Entry);
+  return total;
+}
+
+}  // namespace exynos::mem
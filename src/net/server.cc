@@ -0,0 +1,499 @@
+#include "exynos/net/server.h"
+
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+namespace exynos::net {
+
+namespace {
+
+constexpr std::size_t kReadChunk = 64 * 1024;
+// Caps a single frame; anything larger is a corrupt stream, not a query.
+constexpr std::uint32_t kMaxFrame = 16 * 1024 * 1024;
+constexpr std::size_t kIovBatch = 64;  // iovecs per writev call
+
+void append_raw(std::string& s, const void* p, std::size_t n) {
+  s.append(static_cast<const char*>(p), n);
+}
+
+template <typename T>
+void append_pod(std::string& s, T v) {
+  append_raw(s, &v, sizeof(v));
+}
+
+// Bounds-checked cursor over one request payload; a short read flips
+// `ok` and the frame is answered with an error status.
+struct PayloadReader {
+  const char* p;
+  const char* end;
+  bool ok = true;
+
+  template <typename T>
+  T pod() {
+    T v{};
+    if (static_cast<std::size_t>(end - p) < sizeof(T)) {
+      ok = false;
+      return v;
+    }
+    std::memcpy(&v, p, sizeof(T));
+    p += sizeof(T);
+    return v;
+  }
+  std::string_view bytes(std::size_t n) {
+    if (static_cast<std::size_t>(end - p) < n) {
+      ok = false;
+      return {};
+    }
+    const std::string_view v(p, n);
+    p += n;
+    return v;
+  }
+};
+
+}  // namespace
+
+// One accepted connection. Parsed-but-unsent responses are a list of
+// segments: small owned pieces (headers, lookup results) interleaved
+// with borrowed spans of the ColumnStore mapping, gathered by writev.
+// The deque keeps owned bytes stable while segments accumulate.
+struct Server::Conn {
+  int fd = -1;
+  std::string in;
+
+  std::deque<std::string> owned;
+  struct Seg {
+    const char* base;
+    std::size_t len;
+  };
+  std::vector<Seg> segs;
+
+  // Copied leftovers after a short writev; drained under EPOLLOUT.
+  std::string out;
+  std::size_t out_off = 0;
+  bool want_write = false;
+
+  void push_owned(std::string bytes) {
+    owned.push_back(std::move(bytes));
+    segs.push_back({owned.back().data(), owned.back().size()});
+  }
+  void push_borrowed(const char* base, std::size_t len) {
+    if (len != 0) segs.push_back({base, len});
+  }
+};
+
+Server::Server(const cache::ColumnStore& store, Options opts)
+    : store_(&store), id_index_(store.id_index()), opts_(std::move(opts)) {
+  listen_fd_ =
+      ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listen_fd_ < 0)
+    throw std::system_error(errno, std::generic_category(), "socket");
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (opts_.socket_path.size() >= sizeof(addr.sun_path)) {
+    ::close(listen_fd_);
+    throw std::invalid_argument("socket path too long: " + opts_.socket_path);
+  }
+  std::memcpy(addr.sun_path, opts_.socket_path.c_str(),
+              opts_.socket_path.size() + 1);
+  ::unlink(opts_.socket_path.c_str());
+  if (::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&addr),
+             sizeof(addr)) != 0 ||
+      ::listen(listen_fd_, 128) != 0) {
+    const int err = errno;
+    ::close(listen_fd_);
+    throw std::system_error(err, std::generic_category(),
+                            "bind " + opts_.socket_path);
+  }
+
+  epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    const int err = errno;
+    ::close(listen_fd_);
+    throw std::system_error(err, std::generic_category(), "epoll_create1");
+  }
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.ptr = nullptr;  // nullptr marks the listener
+  ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &ev);
+
+  thread_ = std::thread([this] { loop(); });
+}
+
+Server::~Server() {
+  stop_.store(true, std::memory_order_release);
+  if (thread_.joinable()) thread_.join();
+  if (epoll_fd_ >= 0) ::close(epoll_fd_);
+  if (listen_fd_ >= 0) ::close(listen_fd_);
+  ::unlink(opts_.socket_path.c_str());
+}
+
+void Server::loop() {
+  if (opts_.cpu >= 0) {
+    // Best effort: a denied affinity call just leaves the loop floating.
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<unsigned>(opts_.cpu), &set);
+    (void)::sched_setaffinity(0, sizeof(set), &set);
+  }
+
+  std::unordered_map<int, std::unique_ptr<Conn>> conns;
+  epoll_event events[64];
+  while (!stop_.load(std::memory_order_acquire)) {
+    const int n = ::epoll_wait(epoll_fd_, events, 64, 50);
+    for (int i = 0; i < n; ++i) {
+      if (events[i].data.ptr == nullptr) {
+        for (;;) {
+          const int fd = ::accept4(listen_fd_, nullptr, nullptr,
+                                   SOCK_NONBLOCK | SOCK_CLOEXEC);
+          if (fd < 0) break;
+          auto conn = std::make_unique<Conn>();
+          conn->fd = fd;
+          epoll_event ev{};
+          ev.events = EPOLLIN;
+          ev.data.ptr = conn.get();
+          ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+          conns.emplace(fd, std::move(conn));
+        }
+        continue;
+      }
+
+      Conn& conn = *static_cast<Conn*>(events[i].data.ptr);
+      bool alive = (events[i].events & (EPOLLHUP | EPOLLERR)) == 0;
+      if (alive && (events[i].events & EPOLLIN) != 0)
+        alive = handle_input(conn);
+      if (alive && (events[i].events & EPOLLOUT) != 0) flush(conn);
+      if (!alive) {
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, conn.fd, nullptr);
+        const int fd = conn.fd;
+        ::close(fd);
+        conns.erase(fd);
+      }
+    }
+  }
+  for (auto& [fd, conn] : conns) ::close(fd);
+}
+
+bool Server::handle_input(Conn& conn) {
+  char buf[kReadChunk];
+  for (;;) {
+    const ssize_t n = ::read(conn.fd, buf, sizeof(buf));
+    if (n > 0) {
+      conn.in.append(buf, static_cast<std::size_t>(n));
+      continue;
+    }
+    if (n == 0) return false;  // peer closed
+    if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+    if (errno == EINTR) continue;
+    return false;
+  }
+
+  // Answer every complete frame in the buffer; the flush below gathers
+  // all of them into one writev, which is what makes pipelined batches
+  // cheap — one syscall in, one out, per burst.
+  std::size_t off = 0;
+  auto error_resp = [&](std::string_view msg) {
+    std::string resp;
+    append_pod<std::uint32_t>(
+        resp, static_cast<std::uint32_t>(1 + 2 + msg.size()));
+    append_pod<std::uint8_t>(resp, 1);
+    append_pod<std::uint16_t>(resp, static_cast<std::uint16_t>(msg.size()));
+    append_raw(resp, msg.data(), msg.size());
+    conn.push_owned(std::move(resp));
+  };
+
+  while (conn.in.size() - off >= sizeof(std::uint32_t)) {
+    std::uint32_t len;
+    std::memcpy(&len, conn.in.data() + off, sizeof(len));
+    if (len > kMaxFrame) return false;
+    if (conn.in.size() - off < sizeof(len) + len) break;
+    PayloadReader r{conn.in.data() + off + sizeof(len),
+                    conn.in.data() + off + sizeof(len) + len};
+    off += sizeof(len) + len;
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    switch (const std::uint8_t op = r.pod<std::uint8_t>(); op) {
+      case kLookupBatch: {
+        const std::uint32_t count = r.pod<std::uint32_t>();
+        std::vector<std::string_view> ids;
+        ids.reserve(r.ok ? count : 0);
+        for (std::uint32_t k = 0; r.ok && k < count; ++k)
+          ids.push_back(r.bytes(r.pod<std::uint16_t>()));
+        if (!r.ok) {
+          error_resp("malformed lookup frame");
+          break;
+        }
+        std::vector<std::uint64_t> offsets(ids.size(), index::IdMap::kNotFound);
+        if (id_index_) id_index_->lookup_batch(ids, offsets);
+        std::string resp;
+        resp.reserve(4 + 1 + 4 + offsets.size() * 8);
+        append_pod<std::uint32_t>(
+            resp, static_cast<std::uint32_t>(1 + 4 + offsets.size() * 8));
+        append_pod<std::uint8_t>(resp, 0);
+        append_pod<std::uint32_t>(resp,
+                                  static_cast<std::uint32_t>(offsets.size()));
+        append_raw(resp, offsets.data(), offsets.size() * 8);
+        conn.push_owned(std::move(resp));
+        break;
+      }
+      case kColumnSlice: {
+        const std::string_view name = r.bytes(r.pod<std::uint16_t>());
+        std::uint64_t begin = r.pod<std::uint64_t>();
+        std::uint64_t count = r.pod<std::uint64_t>();
+        if (!r.ok) {
+          error_resp("malformed slice frame");
+          break;
+        }
+        const auto col = store_->find(std::string(name));
+        if (!col) {
+          error_resp("no such column");
+          break;
+        }
+        const char* base;
+        std::size_t elem;
+        if (col->type() == cache::ColumnType::Int64) {
+          base = reinterpret_cast<const char*>(col->ints());
+          elem = sizeof(std::int64_t);
+        } else if (col->type() == cache::ColumnType::String) {
+          base = reinterpret_cast<const char*>(col->codes());
+          elem = sizeof(std::uint32_t);
+        } else {
+          error_resp("unsupported column type");
+          break;
+        }
+        begin = std::min<std::uint64_t>(begin, store_->rows());
+        count = std::min<std::uint64_t>(count, store_->rows() - begin);
+        // Responses obey the same frame cap as requests; a u32 length
+        // prefix cannot carry a multi-GiB slice anyway. The returned
+        // count tells the client how far it got, so it pages with
+        // row_begin += count.
+        count = std::min<std::uint64_t>(count, (kMaxFrame - (1 + 1 + 8)) / elem);
+
+        std::string head;
+        append_pod<std::uint32_t>(
+            head, static_cast<std::uint32_t>(1 + 1 + 8 + count * elem));
+        append_pod<std::uint8_t>(head, 0);
+        append_pod<std::uint8_t>(head, static_cast<std::uint8_t>(col->type()));
+        append_pod<std::uint64_t>(head, count);
+        conn.push_owned(std::move(head));
+        conn.push_borrowed(base + begin * elem,
+                           static_cast<std::size_t>(count * elem));
+        break;
+      }
+      default:
+        error_resp("unknown opcode");
+    }
+  }
+  if (off != 0) conn.in.erase(0, off);
+
+  flush(conn);
+  return true;
+}
+
+void Server::flush(Conn& conn) {
+  // Drain copied leftovers from an earlier short write first, so frames
+  // never reorder.
+  while (conn.out_off < conn.out.size()) {
+    const ssize_t n = ::write(conn.fd, conn.out.data() + conn.out_off,
+                              conn.out.size() - conn.out_off);
+    if (n > 0) {
+      conn.out_off += static_cast<std::size_t>(n);
+      continue;
+    }
+    if (errno == EINTR) continue;
+    break;  // EAGAIN or a real error; the epoll loop decides via events
+  }
+  if (conn.out_off >= conn.out.size()) {
+    conn.out.clear();
+    conn.out_off = 0;
+  }
+
+  std::size_t si = 0;
+  std::size_t soff = 0;
+  while (conn.out.empty() && si < conn.segs.size()) {
+    iovec iov[kIovBatch];
+    std::size_t cnt = 0;
+    for (std::size_t j = si; j < conn.segs.size() && cnt < kIovBatch; ++j) {
+      const std::size_t skip = j == si ? soff : 0;
+      iov[cnt].iov_base =
+          const_cast<char*>(conn.segs[j].base + skip);
+      iov[cnt].iov_len = conn.segs[j].len - skip;
+      ++cnt;
+    }
+    ssize_t n = ::writev(conn.fd, iov, static_cast<int>(cnt));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      break;  // EAGAIN: spill below; errors surface as EPOLLHUP/ERR
+    }
+    auto left = static_cast<std::size_t>(n);
+    while (left != 0 && si < conn.segs.size()) {
+      const std::size_t avail = conn.segs[si].len - soff;
+      if (left < avail) {
+        soff += left;
+        left = 0;
+      } else {
+        left -= avail;
+        ++si;
+        soff = 0;
+      }
+    }
+  }
+
+  if (si < conn.segs.size()) {
+    // Short write: copy what is left (headers plus the tail of a column
+    // slice) and ask for EPOLLOUT. The copy is bounded by the socket
+    // buffer's shortfall, not the response size.
+    for (std::size_t j = si; j < conn.segs.size(); ++j) {
+      const std::size_t skip = j == si ? soff : 0;
+      conn.out.append(conn.segs[j].base + skip, conn.segs[j].len - skip);
+    }
+  }
+  conn.segs.clear();
+  conn.owned.clear();
+
+  const bool pending = !conn.out.empty();
+  if (pending != conn.want_write) {
+    conn.want_write = pending;
+    epoll_event ev{};
+    ev.events = pending ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    ev.data.ptr = &conn;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, conn.fd, &ev);
+  }
+}
+
+namespace {
+
+void write_all(int fd, const void* data, std::size_t len) {
+  const char* p = static_cast<const char*>(data);
+  while (len != 0) {
+    const ssize_t n = ::write(fd, p, len);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw std::system_error(errno, std::generic_category(), "write");
+    }
+    p += n;
+    len -= static_cast<std::size_t>(n);
+  }
+}
+
+void read_exact(int fd, void* data, std::size_t len) {
+  char* p = static_cast<char*>(data);
+  while (len != 0) {
+    const ssize_t n = ::read(fd, p, len);
+    if (n == 0)
+      throw std::system_error(ECONNRESET, std::generic_category(), "read");
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw std::system_error(errno, std::generic_category(), "read");
+    }
+    p += n;
+    len -= static_cast<std::size_t>(n);
+  }
+}
+
+}  // namespace
+
+Client::Client(const std::string& socket_path) {
+  fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0)
+    throw std::system_error(errno, std::generic_category(), "socket");
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (socket_path.size() >= sizeof(addr.sun_path)) {
+    ::close(fd_);
+    throw std::invalid_argument("socket path too long: " + socket_path);
+  }
+  std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+  if (::connect(fd_, reinterpret_cast<const sockaddr*>(&addr),
+                sizeof(addr)) != 0) {
+    const int err = errno;
+    ::close(fd_);
+    throw std::system_error(err, std::generic_category(),
+                            "connect " + socket_path);
+  }
+}
+
+Client::~Client() {
+  if (fd_ >= 0) ::close(fd_);
+}
+
+std::string Client::roundtrip(const std::string& payload) {
+  const auto len = static_cast<std::uint32_t>(payload.size());
+  std::string frame;
+  frame.reserve(sizeof(len) + payload.size());
+  append_pod(frame, len);
+  append_raw(frame, payload.data(), payload.size());
+  write_all(fd_, frame.data(), frame.size());
+
+  std::uint32_t resp_len;
+  read_exact(fd_, &resp_len, sizeof(resp_len));
+  if (resp_len == 0 || resp_len > kMaxFrame)
+    throw std::runtime_error("bad response frame length");
+  std::string resp(resp_len, '\0');
+  read_exact(fd_, resp.data(), resp.size());
+  if (resp[0] != 0) {
+    PayloadReader r{resp.data() + 1, resp.data() + resp.size()};
+    const std::string_view msg = r.bytes(r.pod<std::uint16_t>());
+    throw std::runtime_error("server error: " + std::string(msg));
+  }
+  return resp.substr(1);
+}
+
+std::vector<std::uint64_t> Client::lookup_batch(
+    const std::vector<std::string_view>& ids) {
+  std::string payload;
+  append_pod<std::uint8_t>(payload, Server::kLookupBatch);
+  append_pod<std::uint32_t>(payload, static_cast<std::uint32_t>(ids.size()));
+  for (const std::string_view id : ids) {
+    append_pod<std::uint16_t>(payload, static_cast<std::uint16_t>(id.size()));
+    append_raw(payload, id.data(), id.size());
+  }
+  const std::string body = roundtrip(payload);
+
+  PayloadReader r{body.data(), body.data() + body.size()};
+  const std::uint32_t count = r.pod<std::uint32_t>();
+  std::vector<std::uint64_t> offsets(count, 0);
+  const std::string_view raw = r.bytes(count * sizeof(std::uint64_t));
+  if (!r.ok) throw std::runtime_error("short lookup response");
+  std::memcpy(offsets.data(), raw.data(), raw.size());
+  return offsets;
+}
+
+Client::Slice Client::column_slice(const std::string& column,
+                                   std::uint64_t row_begin,
+                                   std::uint64_t row_count) {
+  std::string payload;
+  append_pod<std::uint8_t>(payload, Server::kColumnSlice);
+  append_pod<std::uint16_t>(payload, static_cast<std::uint16_t>(column.size()));
+  append_raw(payload, column.data(), column.size());
+  append_pod<std::uint64_t>(payload, row_begin);
+  append_pod<std::uint64_t>(payload, row_count);
+  const std::string body = roundtrip(payload);
+
+  PayloadReader r{body.data(), body.data() + body.size()};
+  Slice slice;
+  slice.type = static_cast<cache::ColumnType>(r.pod<std::uint8_t>());
+  const std::uint64_t count = r.pod<std::uint64_t>();
+  const std::string_view raw =
+      r.bytes(static_cast<std::size_t>(body.size() - (r.p - body.data())));
+  if (!r.ok) throw std::runtime_error("short slice response");
+  (void)count;
+  slice.bytes.assign(raw.data(), raw.size());
+  return slice;
+}
+
+}  // namespace exynos::net
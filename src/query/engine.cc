@@ -0,0 +1,845 @@
+#include "exynos/query/engine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "exynos/cache/block_store.h"
+#include "exynos/index/time_index.h"
+#include "exynos/query/sketch.h"
+#include "exynos/query/task.h"
+#include "exynos/trace/trace.h"
+
+namespace exynos::query {
+
+namespace {
+
+using cache::ColumnStore;
+using cache::ColumnType;
+
+// ANDs `sel[i] &= (vals[i] op x)` over the batch. One kernel per
+// comparison so each loop body is a single branchless compare.
+template <CmpOp Op>
+void filter_i64(const std::int64_t* vals, std::size_t n, std::int64_t x,
+                std::uint8_t* sel) {
+#if defined(__ARM_NEON)
+  const int64x2_t vx = vdupq_n_s64(x);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const int64x2_t v = vld1q_s64(vals + i);
+    uint64x2_t m;
+    if constexpr (Op == CmpOp::Eq) m = vceqq_s64(v, vx);
+    if constexpr (Op == CmpOp::Ne) m = vceqq_s64(v, vx);
+    if constexpr (Op == CmpOp::Lt) m = vcltq_s64(v, vx);
+    if constexpr (Op == CmpOp::Le) m = vcleq_s64(v, vx);
+    if constexpr (Op == CmpOp::Gt) m = vcgtq_s64(v, vx);
+    if constexpr (Op == CmpOp::Ge) m = vcgeq_s64(v, vx);
+    std::uint64_t m0 = vgetq_lane_u64(m, 0), m1 = vgetq_lane_u64(m, 1);
+    if constexpr (Op == CmpOp::Ne) {
+      m0 = ~m0;
+      m1 = ~m1;
+    }
+    sel[i] &= static_cast<std::uint8_t>(m0 & 1);
+    sel[i + 1] &= static_cast<std::uint8_t>(m1 & 1);
+  }
+  for (; i < n; ++i) {
+#else
+  for (std::size_t i = 0; i < n; ++i) {
+#endif
+    bool keep;
+    if constexpr (Op == CmpOp::Eq) keep = vals[i] == x;
+    if constexpr (Op == CmpOp::Ne) keep = vals[i] != x;
+    if constexpr (Op == CmpOp::Lt) keep = vals[i] < x;
+    if constexpr (Op == CmpOp::Le) keep = vals[i] <= x;
+    if constexpr (Op == CmpOp::Gt) keep = vals[i] > x;
+    if constexpr (Op == CmpOp::Ge) keep = vals[i] >= x;
+    sel[i] &= static_cast<std::uint8_t>(keep);
+  }
+}
+
+void dispatch_i64(CmpOp op, const std::int64_t* vals, std::size_t n,
+                  std::int64_t x, std::uint8_t* sel) {
+  switch (op) {
+    case CmpOp::Eq: filter_i64<CmpOp::Eq>(vals, n, x, sel); break;
+    case CmpOp::Ne: filter_i64<CmpOp::Ne>(vals, n, x, sel); break;
+    case CmpOp::Lt: filter_i64<CmpOp::Lt>(vals, n, x, sel); break;
+    case CmpOp::Le: filter_i64<CmpOp::Le>(vals, n, x, sel); break;
+    case CmpOp::Gt: filter_i64<CmpOp::Gt>(vals, n, x, sel); break;
+    case CmpOp::Ge: filter_i64<CmpOp::Ge>(vals, n, x, sel); break;
+  }
+}
+
+// Dictionary-code equality over a batch of u32 codes.
+void filter_codes(const std::uint32_t* codes, std::size_t n,
+                  std::uint32_t code, bool negate, std::uint8_t* sel) {
+#if defined(__ARM_NEON)
+  const uint32x4_t vx = vdupq_n_u32(code);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint32x4_t m = vceqq_u32(vld1q_u32(codes + i), vx);
+    if (negate) m = vmvnq_u32(m);
+    sel[i] &= static_cast<std::uint8_t>(vgetq_lane_u32(m, 0) & 1);
+    sel[i + 1] &= static_cast<std::uint8_t>(vgetq_lane_u32(m, 1) & 1);
+    sel[i + 2] &= static_cast<std::uint8_t>(vgetq_lane_u32(m, 2) & 1);
+    sel[i + 3] &= static_cast<std::uint8_t>(vgetq_lane_u32(m, 3) & 1);
+  }
+  for (; i < n; ++i)
+#else
+  for (std::size_t i = 0; i < n; ++i)
+#endif
+    sel[i] &= static_cast<std::uint8_t>((codes[i] == code) != negate);
+}
+
+// ANDs the column's validity bits into the selection mask.
+void filter_valid(const ColumnStore::Column& col, std::uint64_t base,
+                  std::size_t n, std::uint8_t* sel) {
+  for (std::size_t i = 0; i < n; ++i)
+    sel[i] &= static_cast<std::uint8_t>(col.is_valid(base + i));
+}
+
+std::uint32_t dict_code_for(const ColumnStore::Column& col,
+                            std::string_view value, bool& found) {
+  const std::uint64_t n = col.dict_size();
+  for (std::uint32_t c = 0; c < n; ++c) {
+    if (col.dict_entry(c) == value) {
+      found = true;
+      return c;
+    }
+  }
+  found = false;
+  return 0;
+}
+
+struct BoundPredicate {
+  ColumnStore::Column col;
+  CmpOp op;
+  std::int64_t value = 0;
+  std::uint32_t code = 0;
+  bool is_string = false;
+  bool code_found = false;
+};
+
+// Binds the query's filters against `store`, validating column names and
+// types and resolving string values to dictionary codes. Returns false
+// when some predicate can never match (Eq against a value absent from
+// the dictionary), in which case the whole scan is empty.
+bool bind_predicates(const ColumnStore& store, const Query& query,
+                     std::vector<BoundPredicate>& preds) {
+  for (const Predicate& p : query.filters) {
+    auto col = store.find(p.column);
+    if (!col) throw std::invalid_argument("no such column: " + p.column);
+    BoundPredicate bound{*col, p.op, p.value, 0, false, false};
+    if (col->type() == ColumnType::String) {
+      if (p.op != CmpOp::Eq && p.op != CmpOp::Ne)
+        throw std::invalid_argument("string column supports Eq/Ne: " +
+                                    p.column);
+      bound.is_string = true;
+      bound.code = dict_code_for(*col, p.str_value, bound.code_found);
+      if (!bound.code_found && p.op == CmpOp::Eq) return false;
+    } else if (col->type() == ColumnType::Double) {
+      throw std::invalid_argument("double predicate columns not supported: " +
+                                  p.column);
+    }
+    preds.push_back(bound);
+  }
+  return true;
+}
+
+// ANDs every bound predicate (validity bits included) into the batch's
+// selection mask.
+void apply_filters(const std::vector<BoundPredicate>& preds,
+                   std::uint64_t base, std::size_t n, std::uint8_t* sel) {
+  for (const BoundPredicate& p : preds) {
+    filter_valid(p.col, base, n, sel);
+    if (p.is_string) {
+      if (!p.code_found) {
+        // Ne against an absent value keeps every valid row.
+        continue;
+      }
+      filter_codes(p.col.codes() + base, n, p.code, p.op == CmpOp::Ne, sel);
+    } else if (p.col.type() == ColumnType::Bool) {
+      const std::uint8_t* b = p.col.bools() + base;
+      for (std::size_t i = 0; i < n; ++i)
+        sel[i] &= static_cast<std::uint8_t>((b[i] == p.value) ==
+                                            (p.op == CmpOp::Eq));
+    } else {
+      dispatch_i64(p.op, p.col.ints() + base, n, p.value, sel);
+    }
+  }
+}
+
+// Time-range pruning: folds the range predicates on `time_column` into
+// [lo, hi] and lets the index pick the row ranges that can intersect it.
+// Without an applicable index the single full-table span survives.
+std::vector<index::RowRange> prune_spans(const index::TimeIndex* index,
+                                         const std::string& time_column,
+                                         const Query& query,
+                                         std::uint64_t rows) {
+  std::vector<index::RowRange> spans{{0, rows}};
+  if (index == nullptr || index->empty()) return spans;
+  std::int64_t lo = std::numeric_limits<std::int64_t>::min();
+  std::int64_t hi = std::numeric_limits<std::int64_t>::max();
+  bool bounded = false;
+  bool impossible = false;
+  for (const Predicate& p : query.filters) {
+    if (p.column != time_column) continue;
+    switch (p.op) {
+      case CmpOp::Eq:
+        lo = std::max(lo, p.value);
+        hi = std::min(hi, p.value);
+        bounded = true;
+        break;
+      case CmpOp::Ge:
+        lo = std::max(lo, p.value);
+        bounded = true;
+        break;
+      case CmpOp::Gt:
+        if (p.value == std::numeric_limits<std::int64_t>::max())
+          impossible = true;
+        else
+          lo = std::max(lo, p.value + 1);
+        bounded = true;
+        break;
+      case CmpOp::Le:
+        hi = std::min(hi, p.value);
+        bounded = true;
+        break;
+      case CmpOp::Lt:
+        if (p.value == std::numeric_limits<std::int64_t>::min())
+          impossible = true;
+        else
+          hi = std::min(hi, p.value - 1);
+        bounded = true;
+        break;
+      case CmpOp::Ne:
+        break;  // excludes one instant; no range to narrow
+    }
+  }
+  if (impossible)
+    spans.clear();
+  else if (bounded)
+    spans = index->query(lo, hi);
+  return spans;
+}
+
+}  // namespace
+
+Result Engine::run(const Query& query) const {
+  EXYNOS_TRACE_SCOPE("query.run");
+  const ColumnStore& store = *store_;
+  Result result;
+  result.rows_scanned = store.rows();
+
+  // Bind columns once up front.
+  std::vector<BoundPredicate> preds;
+  if (!bind_predicates(store, query, preds)) return result;
+
+  std::optional<ColumnStore::Column> group;
+  std::uint64_t group_count = 1;
+  if (!query.group_by.empty()) {
+    group = store.find(query.group_by);
+    if (!group || group->type() != ColumnType::String)
+      throw std::invalid_argument("group_by must name a string column");
+    group_count = group->dict_size();
+  }
+
+  std::optional<ColumnStore::Column> agg_col;
+  if (query.agg != AggOp::Count) {
+    agg_col = store.find(query.agg_column);
+    if (!agg_col || agg_col->type() != ColumnType::Int64)
+      throw std::invalid_argument("aggregate needs an int64 column");
+  }
+
+  const std::int64_t init = query.agg == AggOp::Min
+                                ? std::numeric_limits<std::int64_t>::max()
+                                : query.agg == AggOp::Max
+                                      ? std::numeric_limits<std::int64_t>::min()
+                                      : 0;
+  struct Partial {
+    std::vector<std::int64_t> acc;
+    std::vector<std::uint64_t> hit;
+    std::uint64_t selected = 0;
+  };
+
+  const std::uint64_t rows = store.rows();
+
+  const std::vector<index::RowRange> spans =
+      prune_spans(time_index_, time_column_, query, rows);
+  std::uint64_t span_rows = 0;
+  for (const index::RowRange& s : spans) span_rows += s.end - s.begin;
+  result.rows_scanned = span_rows;
+  result.rows_pruned = rows - span_rows;
+
+  auto scan_range = [&](std::uint64_t row_begin, std::uint64_t row_end,
+                        Partial& out) {
+    std::uint8_t sel[kBatchRows];
+    for (std::uint64_t base = row_begin; base < row_end; base += kBatchRows) {
+      const std::size_t n = static_cast<std::size_t>(
+          std::min<std::uint64_t>(kBatchRows, row_end - base));
+      std::fill(sel, sel + n, std::uint8_t{1});
+
+      apply_filters(preds, base, n, sel);
+      if (group) filter_valid(*group, base, n, sel);
+      if (agg_col) filter_valid(*agg_col, base, n, sel);
+
+      const std::uint32_t* gcodes = group ? group->codes() + base : nullptr;
+      const std::int64_t* avals = agg_col ? agg_col->ints() + base : nullptr;
+      for (std::size_t i = 0; i < n; ++i) {
+        if (!sel[i]) continue;
+        const std::uint64_t g = gcodes != nullptr ? gcodes[i] : 0;
+        ++out.hit[g];
+        ++out.selected;
+        switch (query.agg) {
+          case AggOp::Count:
+            ++out.acc[g];
+            break;
+          case AggOp::Sum:
+            out.acc[g] += avals[i];
+            break;
+          case AggOp::Min:
+            out.acc[g] = std::min(out.acc[g], avals[i]);
+            break;
+          case AggOp::Max:
+            out.acc[g] = std::max(out.acc[g], avals[i]);
+            break;
+        }
+      }
+    }
+  };
+
+  Partial total{std::vector<std::int64_t>(group_count, init),
+                std::vector<std::uint64_t>(group_count, 0), 0};
+  // Parallel scans only pay off past a few ranges' worth of rows.
+  const std::uint64_t kMinParallelRows = kBatchRows * 8;
+  if (pool_ != nullptr && span_rows >= kMinParallelRows) {
+    const std::size_t ranges = pool_->worker_count() * 4;
+    // Range bounds stay batch-aligned so sel masks never straddle tasks.
+    const std::uint64_t per =
+        ((span_rows / ranges + kBatchRows) / kBatchRows) * kBatchRows;
+    std::vector<index::RowRange> tasks;
+    for (const index::RowRange& s : spans)
+      for (std::uint64_t b = s.begin; b < s.end; b += per)
+        tasks.push_back({b, std::min(s.end, b + per)});
+    std::vector<Partial> partials;
+    partials.assign(tasks.size(),
+                    Partial{std::vector<std::int64_t>(group_count, init),
+                            std::vector<std::uint64_t>(group_count, 0), 0});
+    pool_->parallel_for(tasks.size(), [&](std::size_t r) {
+      scan_range(tasks[r].begin, tasks[r].end, partials[r]);
+    });
+    for (const Partial& p : partials) {
+      total.selected += p.selected;
+      for (std::uint64_t g = 0; g < group_count; ++g) {
+        total.hit[g] += p.hit[g];
+        switch (query.agg) {
+          case AggOp::Count:
+          case AggOp::Sum:
+            total.acc[g] += p.acc[g];
+            break;
+          case AggOp::Min:
+            total.acc[g] = std::min(total.acc[g], p.acc[g]);
+            break;
+          case AggOp::Max:
+            total.acc[g] = std::max(total.acc[g], p.acc[g]);
+            break;
+        }
+      }
+    }
+  } else {
+    for (const index::RowRange& s : spans) scan_range(s.begin, s.end, total);
+  }
+
+  std::vector<std::int64_t>& acc = total.acc;
+  std::vector<std::uint64_t>& hit = total.hit;
+  result.rows_selected = total.selected;
+
+  for (std::uint64_t g = 0; g < group_count; ++g) {
+    if (hit[g] == 0) continue;  // empty groups are omitted
+    GroupResult gr;
+    if (group) gr.key = std::string(group->dict_entry(
+        static_cast<std::uint32_t>(g)));
+    gr.value = acc[g];
+    result.groups.push_back(std::move(gr));
+  }
+  std::sort(result.groups.begin(), result.groups.end(),
+            [](const GroupResult& a, const GroupResult& b) {
+              return a.value != b.value ? a.value > b.value : a.key < b.key;
+            });
+  return result;
+}
+
+Result Engine::top_k(const Query& query, std::size_t k) const {
+  EXYNOS_TRACE_SCOPE("query.top_k");
+  const ColumnStore& store = *store_;
+  Result result;
+  if (query.group_by.empty())
+    throw std::invalid_argument("top_k needs a group_by column");
+  auto group = store.find(query.group_by);
+  if (!group || group->type() != ColumnType::String)
+    throw std::invalid_argument("group_by must name a string column");
+
+  std::vector<BoundPredicate> preds;
+  if (!bind_predicates(store, query, preds)) return result;
+
+  const std::vector<index::RowRange> spans =
+      prune_spans(time_index_, time_column_, query, store.rows());
+  for (const index::RowRange& s : spans) result.rows_scanned += s.end - s.begin;
+  result.rows_pruned = store.rows() - result.rows_scanned;
+
+  // The scan is serial: the whole point of the sketch is that it fits in
+  // L2 on one core, and per-candidate merge of partial top-k sets could
+  // drop a group that is heavy overall but light in every partial.
+  TopK top(k);
+  std::uint8_t sel[kBatchRows];
+  for (const index::RowRange& s : spans) {
+    for (std::uint64_t base = s.begin; base < s.end; base += kBatchRows) {
+      const std::size_t n = static_cast<std::size_t>(
+          std::min<std::uint64_t>(kBatchRows, s.end - base));
+      std::fill(sel, sel + n, std::uint8_t{1});
+      apply_filters(preds, base, n, sel);
+      filter_valid(*group, base, n, sel);
+      const std::uint32_t* codes = group->codes() + base;
+      for (std::size_t i = 0; i < n; ++i) {
+        if (!sel[i]) continue;
+        ++result.rows_selected;
+        top.add(codes[i]);
+      }
+    }
+  }
+
+  for (const TopK::Item& item : top.items())
+    result.groups.push_back(
+        {std::string(group->dict_entry(static_cast<std::uint32_t>(item.key))),
+         static_cast<std::int64_t>(item.count)});
+  return result;
+}
+
+Result Engine::distinct(const Query& query, const std::string& column) const {
+  EXYNOS_TRACE_SCOPE("query.distinct");
+  const ColumnStore& store = *store_;
+  Result result;
+  auto col = store.find(column);
+  if (!col || col->type() != ColumnType::String)
+    throw std::invalid_argument("distinct needs a string column");
+
+  std::vector<BoundPredicate> preds;
+  if (!bind_predicates(store, query, preds)) {
+    result.groups.push_back({"", 0});
+    return result;
+  }
+
+  const std::vector<index::RowRange> spans =
+      prune_spans(time_index_, time_column_, query, store.rows());
+  for (const index::RowRange& s : spans) result.rows_scanned += s.end - s.begin;
+  result.rows_pruned = store.rows() - result.rows_scanned;
+
+  HyperLogLog hll;
+  std::uint8_t sel[kBatchRows];
+  for (const index::RowRange& s : spans) {
+    for (std::uint64_t base = s.begin; base < s.end; base += kBatchRows) {
+      const std::size_t n = static_cast<std::size_t>(
+          std::min<std::uint64_t>(kBatchRows, s.end - base));
+      std::fill(sel, sel + n, std::uint8_t{1});
+      apply_filters(preds, base, n, sel);
+      filter_valid(*col, base, n, sel);
+      const std::uint32_t* codes = col->codes() + base;
+      for (std::size_t i = 0; i < n; ++i) {
+        if (!sel[i]) continue;
+        ++result.rows_selected;
+        hll.add(codes[i]);
+      }
+    }
+  }
+
+  result.groups.push_back(
+      {"", static_cast<std::int64_t>(hll.estimate())});
+  return result;
+}
+
+namespace {
+
+// Decoded view of one raw block chunk (see block_store.h for the layout).
+struct ChunkView {
+  const std::int64_t* ints = nullptr;
+  const std::uint8_t* bools = nullptr;
+  const std::uint32_t* codes = nullptr;
+  std::uint64_t dict_n = 0;
+  const std::uint64_t* dict_offsets = nullptr;
+  const char* dict_bytes = nullptr;
+  const std::uint8_t* valid = nullptr;
+
+  bool is_valid(std::uint32_t row) const {
+    return (valid[row >> 3] >> (row & 7)) & 1;
+  }
+  std::string_view dict_entry(std::uint32_t code) const {
+    return {dict_bytes + dict_offsets[code],
+            static_cast<std::size_t>(dict_offsets[code + 1] -
+                                     dict_offsets[code])};
+  }
+  // Local dictionary code for `value`, or dict_n when absent. The
+  // per-block dictionary is small, linear scan is fine.
+  std::uint32_t dict_find(std::string_view value) const {
+    for (std::uint32_t c = 0; c < dict_n; ++c)
+      if (dict_entry(c) == value) return c;
+    return static_cast<std::uint32_t>(dict_n);
+  }
+};
+
+ChunkView parse_chunk(ColumnType type, std::string_view raw,
+                      std::uint32_t rows) {
+  ChunkView v;
+  const char* p = raw.data();
+  switch (type) {
+    case ColumnType::Int64:
+      v.ints = reinterpret_cast<const std::int64_t*>(p);
+      p += rows * sizeof(std::int64_t);
+      break;
+    case ColumnType::Double:
+      p += rows * sizeof(double);
+      break;
+    case ColumnType::Bool:
+      v.bools = reinterpret_cast<const std::uint8_t*>(p);
+      p += rows;
+      break;
+    case ColumnType::String: {
+      v.codes = reinterpret_cast<const std::uint32_t*>(p);
+      p += (rows * sizeof(std::uint32_t) + 7) & ~std::size_t{7};
+      std::memcpy(&v.dict_n, p, sizeof(v.dict_n));
+      p += sizeof(std::uint64_t);
+      v.dict_offsets = reinterpret_cast<const std::uint64_t*>(p);
+      p += (v.dict_n + 1) * sizeof(std::uint64_t);
+      v.dict_bytes = p;
+      p += v.dict_offsets[v.dict_n];
+      break;
+    }
+  }
+  v.valid = reinterpret_cast<const std::uint8_t*>(p);
+  return v;
+}
+
+// True when a chunk's [min, max] zone could still satisfy `op value`.
+bool zone_may_match(const cache::ChunkDesc& d, CmpOp op, std::int64_t x) {
+  if (d.min > d.max) return false;  // no valid rows in the chunk
+  switch (op) {
+    case CmpOp::Eq: return x >= d.min && x <= d.max;
+    case CmpOp::Ne: return !(d.min == d.max && d.min == x);
+    case CmpOp::Lt: return d.min < x;
+    case CmpOp::Le: return d.min <= x;
+    case CmpOp::Gt: return d.max > x;
+    case CmpOp::Ge: return d.max >= x;
+  }
+  return true;
+}
+
+}  // namespace
+
+namespace {
+
+// Bound form of a Query against a BlockStore: validation and column
+// resolution happen once, then the same plan drives the synchronous scan
+// and the coroutine pipeline.
+struct BlockPred {
+  std::uint32_t col;
+  ColumnType type;
+  CmpOp op;
+  std::int64_t value;
+  std::string_view str_value;
+};
+
+struct BlockPlan {
+  std::vector<BlockPred> preds;
+  std::optional<std::uint32_t> group;
+  std::optional<std::uint32_t> agg_col;
+  std::int64_t init = 0;
+};
+
+BlockPlan plan_blocks(const cache::BlockStore& store, const Query& query) {
+  BlockPlan plan;
+  for (const Predicate& p : query.filters) {
+    auto col = store.find_column(p.column);
+    if (!col) throw std::invalid_argument("no such column: " + p.column);
+    const auto type = static_cast<ColumnType>(store.column_type(*col));
+    if (type == ColumnType::String) {
+      if (p.op != CmpOp::Eq && p.op != CmpOp::Ne)
+        throw std::invalid_argument("string column supports Eq/Ne: " +
+                                    p.column);
+    } else if (type == ColumnType::Double) {
+      throw std::invalid_argument("double predicate columns not supported: " +
+                                  p.column);
+    }
+    plan.preds.push_back({*col, type, p.op, p.value, p.str_value});
+  }
+
+  if (!query.group_by.empty()) {
+    plan.group = store.find_column(query.group_by);
+    if (!plan.group ||
+        static_cast<ColumnType>(store.column_type(*plan.group)) !=
+            ColumnType::String)
+      throw std::invalid_argument("group_by must name a string column");
+  }
+  if (query.agg != AggOp::Count) {
+    plan.agg_col = store.find_column(query.agg_column);
+    if (!plan.agg_col ||
+        static_cast<ColumnType>(store.column_type(*plan.agg_col)) !=
+            ColumnType::Int64)
+      throw std::invalid_argument("aggregate needs an int64 column");
+  }
+  plan.init = query.agg == AggOp::Min
+                  ? std::numeric_limits<std::int64_t>::max()
+                  : query.agg == AggOp::Max
+                        ? std::numeric_limits<std::int64_t>::min()
+                        : 0;
+  return plan;
+}
+
+bool zones_skip_block(const cache::BlockStore& store, const BlockPlan& plan,
+                      std::uint64_t block) {
+  for (const BlockPred& p : plan.preds) {
+    if (p.type == ColumnType::String) continue;  // no zone map
+    if (!zone_may_match(store.chunk(block, p.col), p.op, p.value)) return true;
+  }
+  return false;
+}
+
+// Every decompressed chunk one block evaluation needs: one scratch (and
+// raw view, which may alias the file mapping for uncompressed chunks)
+// per predicate, plus slots for the group and aggregate columns.
+struct FetchedBlock {
+  std::uint32_t rows = 0;
+  std::vector<std::vector<char>> scratches;
+  std::vector<std::string_view> raws;
+};
+
+FetchedBlock fetch_block(const cache::BlockStore& store, const BlockPlan& plan,
+                         std::uint64_t block) {
+  EXYNOS_TRACE_SCOPE("query.fetch_block");
+  FetchedBlock out;
+  out.rows = store.block_row_count(block);
+  out.scratches.resize(plan.preds.size() + 2);
+  out.raws.resize(plan.preds.size() + 2);
+  for (std::size_t i = 0; i < plan.preds.size(); ++i)
+    out.raws[i] = store.read_chunk(block, plan.preds[i].col, out.scratches[i]);
+  if (plan.group)
+    out.raws[plan.preds.size()] =
+        store.read_chunk(block, *plan.group, out.scratches[plan.preds.size()]);
+  if (plan.agg_col)
+    out.raws[plan.preds.size() + 1] = store.read_chunk(
+        block, *plan.agg_col, out.scratches[plan.preds.size() + 1]);
+  return out;
+}
+
+// Block dictionaries are local, so group keys accumulate by string.
+struct BlockAcc {
+  std::int64_t value;
+  std::uint64_t hit = 0;
+};
+
+void scan_block(const Query& query, const BlockPlan& plan,
+                const FetchedBlock& fetched,
+                std::map<std::string, BlockAcc>& groups, Result& result) {
+  const std::uint32_t rows = fetched.rows;
+  result.rows_scanned += rows;
+
+  struct BoundChunk {
+    ChunkView view;
+    std::uint32_t code = 0;  // resolved local code for string preds
+    bool code_found = false;
+  };
+  std::vector<BoundChunk> bound(plan.preds.size());
+  for (std::size_t i = 0; i < plan.preds.size(); ++i) {
+    bound[i].view = parse_chunk(plan.preds[i].type, fetched.raws[i], rows);
+    if (plan.preds[i].type == ColumnType::String) {
+      const std::uint32_t code =
+          bound[i].view.dict_find(plan.preds[i].str_value);
+      bound[i].code = code;
+      bound[i].code_found = code < bound[i].view.dict_n;
+      // Eq against a value absent from this block's dictionary: nothing
+      // in the block can match.
+      if (!bound[i].code_found && plan.preds[i].op == CmpOp::Eq) return;
+    }
+  }
+  ChunkView gview, aview;
+  if (plan.group)
+    gview = parse_chunk(ColumnType::String, fetched.raws[plan.preds.size()],
+                        rows);
+  if (plan.agg_col)
+    aview = parse_chunk(ColumnType::Int64,
+                        fetched.raws[plan.preds.size() + 1], rows);
+
+  for (std::uint32_t r = 0; r < rows; ++r) {
+    bool keep = true;
+    for (std::size_t i = 0; i < plan.preds.size() && keep; ++i) {
+      const BlockPred& p = plan.preds[i];
+      const ChunkView& v = bound[i].view;
+      if (!v.is_valid(r)) {
+        keep = false;
+        break;
+      }
+      switch (p.type) {
+        case ColumnType::String:
+          if (!bound[i].code_found)  // Ne vs absent keeps valid rows
+            keep = p.op == CmpOp::Ne;
+          else
+            keep = (v.codes[r] == bound[i].code) == (p.op == CmpOp::Eq);
+          break;
+        case ColumnType::Bool:
+          keep = (v.bools[r] == p.value) == (p.op == CmpOp::Eq);
+          break;
+        default:
+          switch (p.op) {
+            case CmpOp::Eq: keep = v.ints[r] == p.value; break;
+            case CmpOp::Ne: keep = v.ints[r] != p.value; break;
+            case CmpOp::Lt: keep = v.ints[r] < p.value; break;
+            case CmpOp::Le: keep = v.ints[r] <= p.value; break;
+            case CmpOp::Gt: keep = v.ints[r] > p.value; break;
+            case CmpOp::Ge: keep = v.ints[r] >= p.value; break;
+          }
+      }
+    }
+    if (!keep) continue;
+    if (plan.group && !gview.is_valid(r)) continue;
+    if (plan.agg_col && !aview.is_valid(r)) continue;
+
+    std::string key;
+    if (plan.group) key = std::string(gview.dict_entry(gview.codes[r]));
+    auto [it, inserted] =
+        groups.try_emplace(std::move(key), BlockAcc{plan.init, 0});
+    BlockAcc& acc = it->second;
+    ++acc.hit;
+    ++result.rows_selected;
+    switch (query.agg) {
+      case AggOp::Count: ++acc.value; break;
+      case AggOp::Sum: acc.value += aview.ints[r]; break;
+      case AggOp::Min: acc.value = std::min(acc.value, aview.ints[r]); break;
+      case AggOp::Max: acc.value = std::max(acc.value, aview.ints[r]); break;
+    }
+  }
+}
+
+void finalize_groups(std::map<std::string, BlockAcc>& groups, Result& result) {
+  for (auto& [key, acc] : groups)
+    if (acc.hit != 0) result.groups.push_back({key, acc.value});
+  std::sort(result.groups.begin(), result.groups.end(),
+            [](const GroupResult& a, const GroupResult& b) {
+              return a.value != b.value ? a.value > b.value : a.key < b.key;
+            });
+}
+
+}  // namespace
+
+Result run_blocks(const cache::BlockStore& store, const Query& query) {
+  EXYNOS_TRACE_SCOPE("query.run_blocks");
+  const BlockPlan plan = plan_blocks(store, query);
+  Result result;
+  std::map<std::string, BlockAcc> groups;
+  for (std::uint64_t b = 0; b < store.blocks(); ++b) {
+    if (zones_skip_block(store, plan, b)) {
+      ++result.blocks_skipped;
+      continue;
+    }
+    scan_block(query, plan, fetch_block(store, plan, b), groups, result);
+  }
+  finalize_groups(groups, result);
+  return result;
+}
+
+namespace {
+
+// One in-flight block fetch, started on the pool at submit time and
+// awaited later by the scan coroutine. The completion protocol is a
+// single atomic slot: the worker exchanges in a done sentinel and resumes
+// whichever handle the awaiter parked there first.
+struct AsyncFetch {
+  FetchedBlock block;
+  std::atomic<void*> state{nullptr};
+
+  static void* done_sentinel() {
+    static char tag;
+    return &tag;
+  }
+
+  void start(sched::StealPool& pool, const cache::BlockStore& store,
+             const BlockPlan& plan, std::uint64_t b) {
+    pool.submit([this, &store, &plan, b] {
+      block = fetch_block(store, plan, b);
+      void* waiter = state.exchange(done_sentinel(), std::memory_order_acq_rel);
+      if (waiter != nullptr)
+        std::coroutine_handle<>::from_address(waiter).resume();
+    });
+  }
+
+  auto operator co_await() {
+    struct Awaiter {
+      AsyncFetch* fetch;
+      bool await_ready() {
+        return fetch->state.load(std::memory_order_acquire) == done_sentinel();
+      }
+      bool await_suspend(std::coroutine_handle<> h) {
+        void* expected = nullptr;
+        // Lost the race: the fetch finished first, resume inline.
+        return fetch->state.compare_exchange_strong(
+            expected, h.address(), std::memory_order_acq_rel);
+      }
+      FetchedBlock await_resume() { return std::move(fetch->block); }
+    };
+    return Awaiter{this};
+  }
+};
+
+Task<Result> run_blocks_co(const cache::BlockStore& store, const Query& query,
+                           sched::StealPool& pool, std::size_t window) {
+  const BlockPlan plan = plan_blocks(store, query);
+  Result result;
+  std::map<std::string, BlockAcc> groups;
+
+  // Keep up to `window` decompressions in flight: fetch b+window is
+  // started before block b is scanned, so storage and decompression
+  // overlap with the scan instead of serializing fetch -> scan per block.
+  std::deque<std::unique_ptr<AsyncFetch>> inflight;
+  std::uint64_t next = 0;
+  const std::uint64_t nblocks = store.blocks();
+  auto top_up = [&] {
+    while (inflight.size() < window && next < nblocks) {
+      if (zones_skip_block(store, plan, next)) {
+        ++result.blocks_skipped;
+        ++next;
+        continue;
+      }
+      auto fetch = std::make_unique<AsyncFetch>();
+      fetch->start(pool, store, plan, next);
+      inflight.push_back(std::move(fetch));
+      ++next;
+    }
+  };
+
+  top_up();
+  while (!inflight.empty()) {
+    FetchedBlock fetched = co_await *inflight.front();
+    inflight.pop_front();
+    top_up();  // refill before scanning so the pool stays busy
+    scan_block(query, plan, fetched, groups, result);
+  }
+  finalize_groups(groups, result);
+  co_return result;
+}
+
+}  // namespace
+
+Result run_blocks_async(const cache::BlockStore& store, const Query& query,
+                        sched::StealPool& pool, std::size_t window) {
+  EXYNOS_TRACE_SCOPE("query.run_blocks_async");
+  if (window == 0) window = 1;
+  return run_blocks_co(store, query, pool, window).get();
+}
+
+}  // namespace exynos::query
@@ -0,0 +1,142 @@
+#include "exynos/query/sketch.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace exynos::query {
+
+namespace {
+
+// Same finalizer IdMap uses: enough avalanche that dense dictionary
+// codes land uniformly across rows and registers.
+std::uint64_t mix(std::uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// Row r's cell index: re-mix with an odd per-row multiplier so the rows
+// hash independently (one colliding pair rarely collides twice).
+std::uint64_t row_hash(std::uint64_t key, std::size_t row) {
+  return mix(key * (2 * static_cast<std::uint64_t>(row) + 1) +
+             0x9E3779B97F4A7C15ULL);
+}
+
+}  // namespace
+
+CountMinSketch::CountMinSketch(std::size_t width, std::size_t depth)
+    : width_(std::bit_ceil(std::max<std::size_t>(width, 2))),
+      depth_(std::max<std::size_t>(depth, 1)),
+      counters_(width_ * depth_, 0) {}
+
+void CountMinSketch::add(std::uint64_t key, std::uint64_t count) {
+  for (std::size_t r = 0; r < depth_; ++r)
+    counters_[r * width_ + (row_hash(key, r) & (width_ - 1))] += count;
+}
+
+std::uint64_t CountMinSketch::estimate(std::uint64_t key) const {
+  std::uint64_t est = ~std::uint64_t{0};
+  for (std::size_t r = 0; r < depth_; ++r)
+    est = std::min(est,
+                   counters_[r * width_ + (row_hash(key, r) & (width_ - 1))]);
+  return est;
+}
+
+void CountMinSketch::merge(const CountMinSketch& other) {
+  if (other.width_ != width_ || other.depth_ != depth_)
+    throw std::invalid_argument("CountMinSketch::merge: dimension mismatch");
+  for (std::size_t i = 0; i < counters_.size(); ++i)
+    counters_[i] += other.counters_[i];
+}
+
+TopK::TopK(std::size_t k, std::size_t width, std::size_t depth)
+    : k_(std::max<std::size_t>(k, 1)), sketch_(width, depth) {
+  candidates_.reserve(k_);
+}
+
+void TopK::add(std::uint64_t key) {
+  sketch_.add(key);
+  const std::uint64_t est = sketch_.estimate(key);
+
+  for (Item& c : candidates_) {
+    if (c.key == key) {
+      c.count = est;
+      return;
+    }
+  }
+  if (candidates_.size() < k_) {
+    candidates_.push_back({key, est});
+    if (candidates_.size() == k_)
+      min_count_ = std::min_element(candidates_.begin(), candidates_.end(),
+                                    [](const Item& a, const Item& b) {
+                                      return a.count < b.count;
+                                    })
+                       ->count;
+    return;
+  }
+  // Cheap reject first: most rows belong to keys that never threaten the
+  // resident minimum, so the O(k) eviction scan stays rare.
+  if (est <= min_count_) return;
+  auto victim = std::min_element(
+      candidates_.begin(), candidates_.end(),
+      [](const Item& a, const Item& b) { return a.count < b.count; });
+  *victim = {key, est};
+  min_count_ = std::min_element(candidates_.begin(), candidates_.end(),
+                                [](const Item& a, const Item& b) {
+                                  return a.count < b.count;
+                                })
+                   ->count;
+}
+
+std::vector<TopK::Item> TopK::items() const {
+  std::vector<Item> out = candidates_;
+  std::sort(out.begin(), out.end(), [](const Item& a, const Item& b) {
+    return a.count != b.count ? a.count > b.count : a.key < b.key;
+  });
+  return out;
+}
+
+HyperLogLog::HyperLogLog(unsigned precision)
+    : precision_(std::clamp(precision, 4u, 18u)),
+      registers_(std::size_t{1} << precision_, 0) {}
+
+void HyperLogLog::add(std::uint64_t key) {
+  const std::uint64_t h = mix(key);
+  const std::size_t reg = static_cast<std::size_t>(h >> (64 - precision_));
+  // Rank of the remaining bits: leading-zero run + 1, capped so a zero
+  // suffix still fits the register.
+  const std::uint64_t rest = (h << precision_) | (std::uint64_t{1} << (precision_ - 1));
+  const std::uint8_t rank = static_cast<std::uint8_t>(std::countl_zero(rest) + 1);
+  registers_[reg] = std::max(registers_[reg], rank);
+}
+
+std::uint64_t HyperLogLog::estimate() const {
+  const double m = static_cast<double>(registers_.size());
+  const double alpha = 0.7213 / (1.0 + 1.079 / m);
+  double sum = 0.0;
+  std::size_t zeros = 0;
+  for (const std::uint8_t r : registers_) {
+    sum += 1.0 / static_cast<double>(std::uint64_t{1} << r);
+    if (r == 0) ++zeros;
+  }
+  double est = alpha * m * m / sum;
+  // Small-range correction: with empty registers, linear counting over
+  // the register occupancy is more accurate than the raw estimator.
+  if (est <= 2.5 * m && zeros != 0)
+    est = m * std::log(m / static_cast<double>(zeros));
+  return static_cast<std::uint64_t>(est + 0.5);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+  if (other.precision_ != precision_)
+    throw std::invalid_argument("HyperLogLog::merge: precision mismatch");
+  for (std::size_t i = 0; i < registers_.size(); ++i)
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+}
+
+}  // namespace exynos::query
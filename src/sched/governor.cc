@@ -0,0 +1,204 @@
+#include "exynos/sched/governor.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include "exynos/sched/steal_pool.h"
+#include "exynos/sched/topology.h"
+#include "exynos/trace/trace.h"
+
+namespace exynos::sched {
+
+namespace {
+
+bool read_long(const std::string& path, long& out) {
+  std::FILE* f = std::fopen(path.c_str(), "r");
+  if (f == nullptr) return false;
+  const bool ok = std::fscanf(f, "%ld", &out) == 1;
+  std::fclose(f);
+  return ok;
+}
+
+bool read_word(const std::string& path, char* buf, std::size_t len) {
+  std::FILE* f = std::fopen(path.c_str(), "r");
+  if (f == nullptr) return false;
+  const bool ok = std::fscanf(f, "%31s", buf) == 1;
+  (void)len;
+  std::fclose(f);
+  return ok;
+}
+
+}  // namespace
+
+Governor::Governor(GovernorOptions opts) : opts_(std::move(opts)) {
+  if (opts_.max_workers == 0) {
+    opts_.max_workers = Topology::system().cpu_count();
+    if (opts_.max_workers == 0) opts_.max_workers = 1;
+  }
+  if (opts_.min_workers == 0) opts_.min_workers = 1;
+  if (opts_.min_workers > opts_.max_workers)
+    opts_.min_workers = opts_.max_workers;
+
+  // Discover the zones once; polls then only re-read the temp files.
+  for (int zone = 0;; ++zone) {
+    const std::string dir =
+        opts_.thermal_root + "/thermal_zone" + std::to_string(zone);
+    long temp = 0;
+    if (!read_long(dir + "/temp", temp)) break;
+    zone_temp_paths_.push_back(dir + "/temp");
+  }
+  trip_millic_ = read_trip();
+
+  limit_ = opts_.max_workers;  // optimistic start; first hot poll corrects
+  poll_now();
+
+  if (opts_.poll_interval.count() > 0) {
+    poll_thread_ = std::thread([this] {
+      std::unique_lock<std::mutex> lock(mu_);
+      while (!stopping_) {
+        stop_cv_.wait_for(lock, opts_.poll_interval);
+        if (stopping_) return;
+        lock.unlock();
+        poll_now();
+        lock.lock();
+      }
+    });
+  }
+}
+
+Governor::~Governor() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stopping_ = true;
+  }
+  stop_cv_.notify_all();
+  if (poll_thread_.joinable()) poll_thread_.join();
+}
+
+long Governor::read_trip() const {
+  // Lowest passive/hot trip across the zones: the first clamp the kernel
+  // will actually apply is the budget that matters.
+  long best = -1;
+  for (std::size_t zone = 0; zone < zone_temp_paths_.size(); ++zone) {
+    const std::string dir =
+        opts_.thermal_root + "/thermal_zone" + std::to_string(zone);
+    for (int trip = 0;; ++trip) {
+      const std::string stem = dir + "/trip_point_" + std::to_string(trip);
+      long temp = -1;
+      if (!read_long(stem + "_temp", temp)) break;
+      char type[32] = {0};
+      if (!read_word(stem + "_type", type, sizeof(type))) continue;
+      if (std::strcmp(type, "passive") != 0 && std::strcmp(type, "hot") != 0)
+        continue;
+      if (temp > 0 && (best < 0 || temp < best)) best = temp;
+    }
+  }
+  return best > 0 ? best : opts_.default_trip_millic;
+}
+
+unsigned Governor::background_limit() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return limit_;
+}
+
+long Governor::max_temp_millic() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return last_temp_millic_;
+}
+
+bool Governor::throttled() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return last_throttled_;
+}
+
+void Governor::poll_now() {
+  long hottest = -1;
+  for (const std::string& path : zone_temp_paths_) {
+    long temp = -1;
+    if (read_long(path, temp) && temp > hottest) hottest = temp;
+  }
+
+  // cpufreq already clamping? Compare current against ceiling with a 10%
+  // margin so ordinary DVFS idling does not read as throttling.
+  bool clamped = false;
+  const Topology& topo = Topology::system();
+  for (unsigned cpu = 0; cpu < topo.cpu_count() && !clamped; ++cpu) {
+    const std::string dir =
+        opts_.cpu_root + "/cpu" + std::to_string(cpu) + "/cpufreq";
+    long cur = -1;
+    long max = -1;
+    if (read_long(dir + "/scaling_cur_freq", cur) &&
+        read_long(dir + "/cpuinfo_max_freq", max) && cur > 0 && max > 0 &&
+        cur < max - max / 10)
+      clamped = true;
+  }
+
+  unsigned new_limit;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    last_temp_millic_ = hottest;
+    last_throttled_ = clamped;
+    const long target = trip_millic_ - opts_.headroom_millic;
+    new_limit = limit_;
+    if ((hottest >= 0 && hottest >= trip_millic_) || clamped) {
+      new_limit = limit_ / 2;  // over the line: shed hard
+    } else if (hottest >= 0 && hottest >= target) {
+      new_limit = limit_ - 1;  // inside the headroom band: ease off
+    } else {
+      new_limit = limit_ + 1;  // cool: ramp back one worker per poll
+    }
+    if (new_limit < opts_.min_workers) new_limit = opts_.min_workers;
+    if (new_limit > opts_.max_workers) new_limit = opts_.max_workers;
+    limit_ = new_limit;
+  }
+  EXYNOS_TRACE_COUNTER(bg_limit, "governor.background_limit");
+  bg_limit.add(new_limit);
+  lease_cv_.notify_all();
+}
+
+Governor::Lease Governor::acquire() {
+  std::unique_lock<std::mutex> lock(mu_);
+  lease_cv_.wait(lock, [this] { return active_ < limit_ || stopping_; });
+  ++active_;
+  return Lease(this);
+}
+
+void Governor::release() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    --active_;
+  }
+  lease_cv_.notify_one();
+}
+
+Governor::Lease::~Lease() {
+  if (gov_ != nullptr) gov_->release();
+}
+
+Governor::Lease::Lease(Lease&& other) noexcept : gov_(other.gov_) {
+  other.gov_ = nullptr;
+}
+
+void Governor::parallel_for_paced(
+    StealPool& pool, std::size_t n,
+    const std::function<void(std::size_t)>& fn) {
+  if (n == 0) return;
+  // Same chunking as StealPool::parallel_for; each chunk holds a lease
+  // for its whole run, so a thermal ramp mid-run sheds concurrency at the
+  // next chunk boundary instead of mid-record.
+  const std::size_t chunks = pool.worker_count() * 4;
+  const std::size_t step = (n + chunks - 1) / chunks;
+  for (std::size_t begin = 0; begin < n; begin += step) {
+    const std::size_t end = begin + step < n ? begin + step : n;
+    // shared_ptr because StealPool::Task is a copyable std::function; the
+    // lease releases when the task (the last owner) is destroyed.
+    auto lease = std::make_shared<Lease>(acquire());
+    pool.submit([begin, end, &fn, lease] {
+      for (std::size_t i = begin; i < end; ++i) fn(i);
+    });
+  }
+  pool.wait_idle();
+}
+
+}  // namespace exynos::sched
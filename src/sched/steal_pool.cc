@@ -0,0 +1,223 @@
+#include "exynos/sched/steal_pool.h"
+
+#include <sched.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <utility>
+
+#include "exynos/sched/topology.h"
+
+namespace exynos::sched {
+
+namespace {
+
+long read_max_freq(unsigned cpu) {
+  char path[128];
+  std::snprintf(path, sizeof(path),
+                "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq", cpu);
+  std::FILE* f = std::fopen(path, "r");
+  if (f == nullptr) return -1;
+  long khz = -1;
+  if (std::fscanf(f, "%ld", &khz) != 1) khz = -1;
+  std::fclose(f);
+  return khz;
+}
+
+void pin_self(unsigned cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(static_cast<int>(cpu), &set);
+  (void)::sched_setaffinity(0, sizeof(set), &set);  // best effort
+}
+
+}  // namespace
+
+StealPool::StealPool(unsigned workers) {
+  if (workers == 0) {
+    workers = std::thread::hardware_concurrency();
+    if (workers == 0) workers = 1;
+  }
+
+  // Capacity weights from cpufreq ceilings; flat on machines without
+  // cpufreq (VMs, containers) or with fewer exposed cpus than workers.
+  weights_.assign(workers, 1.0);
+  long best = -1;
+  std::vector<long> freqs(workers, -1);
+  for (unsigned w = 0; w < workers; ++w) {
+    freqs[w] = read_max_freq(w);
+    if (freqs[w] > best) best = freqs[w];
+  }
+  if (best > 0)
+    for (unsigned w = 0; w < workers; ++w)
+      if (freqs[w] > 0) weights_[w] = static_cast<double>(freqs[w]) /
+                                      static_cast<double>(best);
+
+  // Weighted round-robin schedule for external submissions: a worker with
+  // weight 0.5 appears half as often as a full-speed one.
+  for (unsigned w = 0; w < workers; ++w) {
+    const int slots = static_cast<int>(weights_[w] * 4.0 + 0.5);
+    for (int s = 0; s < (slots > 0 ? slots : 1); ++s)
+      submit_schedule_.push_back(w);
+  }
+
+  // Cluster map: worker w pins to cpu w, so its cluster is that cpu's.
+  // With more workers than cpus the assignment wraps, which at least keeps
+  // the wrap-around workers consistent with where they will be scheduled.
+  const Topology& topo = Topology::system();
+  worker_cluster_.resize(workers);
+  cluster_workers_.resize(topo.cluster_count());
+  for (unsigned w = 0; w < workers; ++w) {
+    const unsigned cluster = topo.cluster_of(w % topo.cpu_count());
+    worker_cluster_[w] = cluster;
+    cluster_workers_[cluster].push_back(w);
+  }
+  // Drop clusters no worker landed on so cluster ids stay dense.
+  std::erase_if(cluster_workers_,
+                [](const std::vector<unsigned>& v) { return v.empty(); });
+  for (unsigned c = 0; c < cluster_workers_.size(); ++c)
+    for (unsigned w : cluster_workers_[c]) worker_cluster_[w] = c;
+  cluster_ticket_.assign(cluster_workers_.size(), 0);
+
+  workers_.reserve(workers);
+  for (unsigned w = 0; w < workers; ++w)
+    workers_.push_back(std::make_unique<Worker>());
+  for (unsigned w = 0; w < workers; ++w)
+    workers_[w]->thread = std::thread([this, w] { worker_loop(w); });
+}
+
+StealPool::~StealPool() {
+  {
+    // Not wait_idle(): an uncollected task error must not throw from a
+    // destructor.
+    std::unique_lock<std::mutex> lock(idle_mu_);
+    idle_cv_.wait(lock, [this] { return outstanding_ == 0; });
+    stopping_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& w : workers_) w->thread.join();
+}
+
+void StealPool::submit(Task task) {
+  unsigned target;
+  {
+    std::lock_guard<std::mutex> lock(idle_mu_);
+    target = submit_schedule_[submit_ticket_++ % submit_schedule_.size()];
+    ++outstanding_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(workers_[target]->mu);
+    workers_[target]->queue.push_back(std::move(task));
+  }
+  work_cv_.notify_one();
+}
+
+void StealPool::submit_on_cluster(unsigned cluster, Task task) {
+  unsigned target;
+  {
+    std::lock_guard<std::mutex> lock(idle_mu_);
+    const std::vector<unsigned>& members =
+        cluster_workers_[cluster % cluster_workers_.size()];
+    target = members[cluster_ticket_[cluster % cluster_workers_.size()]++ %
+                     members.size()];
+    ++outstanding_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(workers_[target]->mu);
+    workers_[target]->queue.push_back(std::move(task));
+  }
+  work_cv_.notify_one();
+}
+
+bool StealPool::try_pop(unsigned self, Task& task) {
+  Worker& w = *workers_[self];
+  std::lock_guard<std::mutex> lock(w.mu);
+  if (w.queue.empty()) return false;
+  task = std::move(w.queue.back());  // own work LIFO: warm caches
+  w.queue.pop_back();
+  return true;
+}
+
+bool StealPool::try_steal(unsigned self, Task& task) {
+  const unsigned n = worker_count();
+  thread_local std::minstd_rand rng(std::random_device{}());
+  const unsigned start = static_cast<unsigned>(rng()) % n;
+  // Same-cluster victims first: their queues hold work whose data is
+  // already behind our L3 slice. Cross-cluster stealing is the fallback
+  // that keeps asymmetric finish times from idling a whole cluster.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (unsigned i = 0; i < n; ++i) {
+      const unsigned victim = (start + i) % n;
+      if (victim == self) continue;
+      const bool local = worker_cluster_[victim] == worker_cluster_[self];
+      if (local != (pass == 0)) continue;
+      Worker& w = *workers_[victim];
+      std::lock_guard<std::mutex> lock(w.mu);
+      if (w.queue.empty()) continue;
+      task = std::move(w.queue.front());  // steal FIFO: oldest, coldest work
+      w.queue.pop_front();
+      return true;
+    }
+    if (cluster_workers_.size() == 1) break;  // one cluster: one pass
+  }
+  return false;
+}
+
+void StealPool::worker_loop(unsigned self) {
+  pin_self(self);
+  for (;;) {
+    Task task;
+    if (try_pop(self, task) || try_steal(self, task)) {
+      // An exception must not escape onto the std::thread (terminate) or
+      // skip the outstanding_ decrement (wait_idle hangs). Latch the
+      // first one for wait_idle() to rethrow on a caller thread.
+      std::exception_ptr error;
+      try {
+        task();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(idle_mu_);
+      if (error != nullptr && task_error_ == nullptr) task_error_ = error;
+      if (--outstanding_ == 0) idle_cv_.notify_all();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(idle_mu_);
+    if (stopping_) return;
+    if (outstanding_ == 0) {
+      idle_cv_.notify_all();
+    }
+    work_cv_.wait_for(lock, std::chrono::milliseconds(1));
+    if (stopping_) return;
+  }
+}
+
+void StealPool::wait_idle() {
+  std::unique_lock<std::mutex> lock(idle_mu_);
+  idle_cv_.wait(lock, [this] { return outstanding_ == 0; });
+  if (task_error_ != nullptr) {
+    std::exception_ptr error = std::exchange(task_error_, nullptr);
+    lock.unlock();
+    std::rethrow_exception(error);
+  }
+}
+
+void StealPool::parallel_for(std::size_t n,
+                             const std::function<void(std::size_t)>& fn) {
+  if (n == 0) return;
+  // ~4 chunks per worker so stealing can rebalance asymmetric finish
+  // times without paying per-index dispatch.
+  const std::size_t chunks = worker_count() * 4;
+  const std::size_t step = (n + chunks - 1) / chunks;
+  for (std::size_t begin = 0; begin < n; begin += step) {
+    const std::size_t end = begin + step < n ? begin + step : n;
+    submit([begin, end, &fn] {
+      for (std::size_t i = begin; i < end; ++i) fn(i);
+    });
+  }
+  wait_idle();
+}
+
+}  // namespace exynos::sched
@@ -0,0 +1,112 @@
+#include "exynos/sched/topology.h"
+
+#include <cstdio>
+#include <map>
+#include <thread>
+
+namespace exynos::sched {
+
+namespace {
+
+bool read_long(const std::string& path, long& out) {
+  std::FILE* f = std::fopen(path.c_str(), "r");
+  if (f == nullptr) return false;
+  const bool ok = std::fscanf(f, "%ld", &out) == 1;
+  std::fclose(f);
+  return ok;
+}
+
+// Cache sizes print as "512K" / "4M"; cluster ids as plain integers.
+bool read_size_bytes(const std::string& path, std::uint64_t& out) {
+  std::FILE* f = std::fopen(path.c_str(), "r");
+  if (f == nullptr) return false;
+  long value = -1;
+  char suffix = '\0';
+  const int got = std::fscanf(f, "%ld%c", &value, &suffix);
+  std::fclose(f);
+  if (got < 1 || value < 0) return false;
+  out = static_cast<std::uint64_t>(value);
+  if (suffix == 'K') out <<= 10;
+  if (suffix == 'M') out <<= 20;
+  return true;
+}
+
+// First cpu number in a shared_cpu_list like "4-7" or "0,2,4"; the group
+// leader is a stable stand-in for a cluster id when topology/ lacks one.
+bool read_first_cpu(const std::string& path, long& out) {
+  std::FILE* f = std::fopen(path.c_str(), "r");
+  if (f == nullptr) return false;
+  const bool ok = std::fscanf(f, "%ld", &out) == 1;
+  std::fclose(f);
+  return ok;
+}
+
+}  // namespace
+
+Topology::Topology(const std::string& sysfs_cpu_root) {
+  unsigned ncpu = 0;
+  for (;;) {
+    const std::string dir = sysfs_cpu_root + "/cpu" + std::to_string(ncpu);
+    std::FILE* probe = std::fopen((dir + "/online").c_str(), "r");
+    if (probe == nullptr)
+      probe = std::fopen((dir + "/topology/core_id").c_str(), "r");
+    if (probe == nullptr) break;
+    std::fclose(probe);
+    ++ncpu;
+  }
+  if (ncpu == 0) {
+    // No sysfs tree at all: flat single-cluster fallback sized from the
+    // scheduler so the pools still get a worker per core.
+    ncpu = std::thread::hardware_concurrency();
+    if (ncpu == 0) ncpu = 1;
+    cpus_.resize(ncpu);
+    clusters_.emplace_back();
+    for (unsigned cpu = 0; cpu < ncpu; ++cpu) clusters_[0].push_back(cpu);
+    return;
+  }
+
+  cpus_.resize(ncpu);
+  std::map<long, unsigned> cluster_ids;  // raw id -> dense index
+  for (unsigned cpu = 0; cpu < ncpu; ++cpu) {
+    const std::string dir = sysfs_cpu_root + "/cpu" + std::to_string(cpu);
+    long raw = -1;
+    if (!read_long(dir + "/topology/cluster_id", raw) &&
+        !read_long(dir + "/topology/physical_package_id", raw)) {
+      // Neither id present: group by who shares the highest cache level.
+      for (int idx = 0;; ++idx) {
+        const std::string cache = dir + "/cache/index" + std::to_string(idx);
+        long level = -1;
+        if (!read_long(cache + "/level", level)) break;
+        long leader = -1;
+        if (read_first_cpu(cache + "/shared_cpu_list", leader)) raw = leader;
+      }
+      if (raw < 0) raw = 0;
+    }
+    auto [it, added] =
+        cluster_ids.try_emplace(raw, static_cast<unsigned>(clusters_.size()));
+    if (added) clusters_.emplace_back();
+    cpus_[cpu].cluster = it->second;
+    clusters_[it->second].push_back(cpu);
+
+    long khz = -1;
+    if (read_long(dir + "/cpufreq/cpuinfo_max_freq", khz))
+      cpus_[cpu].max_freq_khz = khz;
+
+    for (int idx = 0;; ++idx) {
+      const std::string cache = dir + "/cache/index" + std::to_string(idx);
+      long level = -1;
+      if (!read_long(cache + "/level", level)) break;
+      std::uint64_t bytes = 0;
+      if (read_size_bytes(cache + "/size", bytes) &&
+          bytes > cpus_[cpu].llc_bytes)
+        cpus_[cpu].llc_bytes = bytes;
+    }
+  }
+}
+
+const Topology& Topology::system() {
+  static const Topology topo;
+  return topo;
+}
+
+}  // namespace exynos::sched
@@ -0,0 +1,231 @@
+#include "exynos/share/snapshot.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include "exynos/jsonl/mmap_reader.h"
+
+namespace exynos::share {
+
+namespace {
+
+constexpr int kSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL;
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+std::atomic_ref<std::uint64_t> seq_ref(const SnapshotControl* ctrl) {
+  // The header lives in a MAP_SHARED file mapping; readers hold it
+  // PROT_READ, so cast away const for the (load-only) atomic_ref.
+  return std::atomic_ref<std::uint64_t>(
+      const_cast<SnapshotControl*>(ctrl)->seq);
+}
+
+}  // namespace
+
+SnapshotPublisher::SnapshotPublisher(const std::string& control_path) {
+  int fd = ::open(control_path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+  if (fd < 0) throw_errno("open " + control_path);
+  if (::ftruncate(fd, sizeof(SnapshotControl)) != 0) {
+    int saved = errno;
+    ::close(fd);
+    errno = saved;
+    throw_errno("ftruncate " + control_path);
+  }
+  void* map = ::mmap(nullptr, sizeof(SnapshotControl), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+  int saved = errno;
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    errno = saved;
+    throw_errno("mmap " + control_path);
+  }
+  ctrl_ = static_cast<SnapshotControl*>(map);
+  if (ctrl_->magic != SnapshotControl::kMagic) {
+    // Fresh control file: no snapshot yet, epoch 0, no fd to chase.
+    ctrl_->seq = 0;
+    ctrl_->pid = 0;
+    ctrl_->fd = -1;
+    ctrl_->bytes = 0;
+    std::memset(ctrl_->reserved, 0, sizeof(ctrl_->reserved));
+    ctrl_->magic = SnapshotControl::kMagic;
+  }
+}
+
+SnapshotPublisher::~SnapshotPublisher() {
+  if (retired_fd_ >= 0) ::close(retired_fd_);
+  if (current_fd_ >= 0) ::close(current_fd_);
+  if (ctrl_ != nullptr) ::munmap(ctrl_, sizeof(SnapshotControl));
+}
+
+std::uint64_t SnapshotPublisher::epoch() const {
+  return seq_ref(ctrl_).load(std::memory_order_acquire);
+}
+
+std::uint64_t SnapshotPublisher::publish(const void* data, std::size_t len) {
+  int fd = static_cast<int>(
+      ::memfd_create("exynos-snapshot", MFD_ALLOW_SEALING | MFD_CLOEXEC));
+  if (fd < 0) throw_errno("memfd_create");
+
+  const char* p = static_cast<const char*>(data);
+  std::size_t done = 0;
+  while (done < len) {
+    ssize_t n = ::write(fd, p + done, len - done);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      int saved = errno;
+      ::close(fd);
+      errno = saved;
+      throw_errno("write snapshot memfd");
+    }
+    done += static_cast<std::size_t>(n);
+  }
+  if (::fcntl(fd, F_ADD_SEALS, kSeals) != 0) {
+    int saved = errno;
+    ::close(fd);
+    errno = saved;
+    throw_errno("seal snapshot memfd");
+  }
+
+  // Seqlock flip: odd while the fields are torn, even once consistent.
+  auto seq = seq_ref(ctrl_);
+  const std::uint64_t s = seq.load(std::memory_order_relaxed);
+  seq.store(s + 1, std::memory_order_release);
+  std::atomic_thread_fence(std::memory_order_release);
+  ctrl_->pid = static_cast<std::int32_t>(::getpid());
+  ctrl_->fd = fd;
+  ctrl_->bytes = len;
+  std::atomic_thread_fence(std::memory_order_release);
+  seq.store(s + 2, std::memory_order_release);
+
+  // Keep the superseded snapshot's fd open for one more generation so a
+  // reader that seqlock-read it just before the flip can still open it.
+  if (retired_fd_ >= 0) ::close(retired_fd_);
+  retired_fd_ = current_fd_;
+  current_fd_ = fd;
+  return s + 2;
+}
+
+std::uint64_t SnapshotPublisher::publish_file(const std::string& path) {
+  jsonl::MmapReader image(path);
+  return publish(image.data().data(), image.size());
+}
+
+Snapshot Snapshot::attach(const std::string& control_path) {
+  int cfd = ::open(control_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (cfd < 0) throw_errno("open " + control_path);
+  void* cmap =
+      ::mmap(nullptr, sizeof(SnapshotControl), PROT_READ, MAP_SHARED, cfd, 0);
+  int saved = errno;
+  ::close(cfd);
+  if (cmap == MAP_FAILED) {
+    errno = saved;
+    throw_errno("mmap " + control_path);
+  }
+  const auto* ctrl = static_cast<const SnapshotControl*>(cmap);
+  if (ctrl->magic != SnapshotControl::kMagic) {
+    ::munmap(cmap, sizeof(SnapshotControl));
+    throw std::runtime_error(control_path + ": not a snapshot control file");
+  }
+
+  auto seq = seq_ref(ctrl);
+  for (;;) {
+    const std::uint64_t s1 = seq.load(std::memory_order_acquire);
+    if (s1 == 0) {
+      ::munmap(cmap, sizeof(SnapshotControl));
+      throw std::runtime_error(control_path + ": no snapshot published");
+    }
+    if (s1 & 1) {  // publisher mid-flip
+      ::sched_yield();
+      continue;
+    }
+    const std::int32_t pid = ctrl->pid;
+    const std::int32_t pfd = ctrl->fd;
+    const std::uint64_t bytes = ctrl->bytes;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq.load(std::memory_order_acquire) != s1) continue;
+
+    const std::string path =
+        "/proc/" + std::to_string(pid) + "/fd/" + std::to_string(pfd);
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+      // The seals prove this is still a published snapshot and not a
+      // reuse of the fd number for something writable.
+      struct stat st;
+      if (::fcntl(fd, F_GET_SEALS) != kSeals || ::fstat(fd, &st) != 0 ||
+          static_cast<std::uint64_t>(st.st_size) != bytes) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+    if (fd < 0) {
+      // Only retry when the publisher actually moved the epoch under us;
+      // a stale-but-stable control block means the publisher is gone and
+      // its /proc window with it — spinning would never terminate.
+      if (seq.load(std::memory_order_acquire) != s1) continue;
+      ::munmap(cmap, sizeof(SnapshotControl));
+      throw std::runtime_error(control_path + ": publisher gone");
+    }
+    void* map = bytes != 0
+                    ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0)
+                    : nullptr;
+    if (bytes != 0 && map == MAP_FAILED) {
+      saved = errno;
+      ::close(fd);
+      ::munmap(cmap, sizeof(SnapshotControl));
+      errno = saved;
+      throw_errno("mmap snapshot segment");
+    }
+
+    Snapshot snap;
+    snap.ctrl_ = ctrl;
+    snap.data_ = static_cast<const char*>(map);
+    snap.size_ = bytes;
+    snap.epoch_ = s1;
+    snap.fd_ = fd;
+    return snap;
+  }
+}
+
+Snapshot::~Snapshot() {
+  if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+  if (fd_ >= 0) ::close(fd_);
+  if (ctrl_ != nullptr)
+    ::munmap(const_cast<SnapshotControl*>(ctrl_), sizeof(SnapshotControl));
+}
+
+Snapshot::Snapshot(Snapshot&& other) noexcept
+    : ctrl_(std::exchange(other.ctrl_, nullptr)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      epoch_(other.epoch_),
+      fd_(std::exchange(other.fd_, -1)) {}
+
+Snapshot& Snapshot::operator=(Snapshot&& other) noexcept {
+  if (this != &other) {
+    this->~Snapshot();
+    new (this) Snapshot(std::move(other));
+  }
+  return *this;
+}
+
+bool Snapshot::stale() const {
+  return seq_ref(ctrl_).load(std::memory_order_acquire) != epoch_;
+}
+
+std::string Snapshot::memfd_path() const {
+  return "/proc/self/fd/" + std::to_string(fd_);
+}
+
+}  // namespace exynos::share
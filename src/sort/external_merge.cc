@@ -0,0 +1,220 @@
+#include "exynos/sort/external_merge.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "exynos/io/uring_writer.h"
+#include "exynos/jsonl/mmap_reader.h"
+#include "exynos/sched/steal_pool.h"
+#include "exynos/trace/trace.h"
+
+namespace exynos::sort {
+
+namespace {
+
+using Entry = ExternalMerge::Entry;
+
+static_assert(sizeof(Entry) == 16, "entries are packed 16-byte records");
+
+// Signed key mapped to unsigned so byte-wise radix orders negatives
+// before positives.
+std::uint64_t biased(std::int64_t key) {
+  return static_cast<std::uint64_t>(key) ^ (std::uint64_t{1} << 63);
+}
+
+// LSD radix sort on (key, value): value bytes first, then the biased key
+// bytes, one byte per pass, ping-ponging between `a` and `scratch`. All
+// sixteen histograms come from a single read of the data, and passes
+// whose byte is constant across the run (the usual case for the high
+// timestamp and offset bytes) are skipped outright, so a realistic run
+// costs far fewer than sixteen scatters.
+void radix_sort(std::vector<Entry>& a, std::vector<Entry>& scratch) {
+  constexpr std::size_t kPasses = 16;
+  const std::size_t n = a.size();
+  if (n < 2) return;
+  scratch.resize(n);
+
+  auto byte_of = [](const Entry& e, std::size_t p) {
+    const std::uint64_t u = p < 8 ? e.value : biased(e.key);
+    return (u >> (8 * (p & 7))) & 0xFF;
+  };
+
+  std::uint64_t hist[kPasses][256] = {};
+  for (const Entry& e : a)
+    for (std::size_t p = 0; p < kPasses; ++p) ++hist[p][byte_of(e, p)];
+
+  Entry* src = a.data();
+  Entry* dst = scratch.data();
+  for (std::size_t p = 0; p < kPasses; ++p) {
+    if (hist[p][byte_of(src[0], p)] == n) continue;  // byte is constant
+    std::uint64_t pos[256];
+    std::uint64_t acc = 0;
+    for (std::size_t b = 0; b < 256; ++b) {
+      pos[b] = acc;
+      acc += hist[p][b];
+    }
+    for (std::size_t i = 0; i < n; ++i) dst[pos[byte_of(src[i], p)]++] = src[i];
+    std::swap(src, dst);
+  }
+  if (src != a.data()) std::memcpy(a.data(), src, n * sizeof(Entry));
+}
+
+bool entry_less(const Entry& x, const Entry& y) {
+  return x.key != y.key ? x.key < y.key : x.value < y.value;
+}
+
+}  // namespace
+
+ExternalMerge::ExternalMerge(Options opts) : opts_(std::move(opts)) {
+  if (opts_.run_entries == 0) opts_.run_entries = 1;
+  buffer_.reserve(opts_.run_entries);
+}
+
+ExternalMerge::~ExternalMerge() {
+  wait_spills();
+  for (std::size_t r = 0; r < runs_; ++r)
+    std::remove((opts_.run_prefix + ".run" + std::to_string(r)).c_str());
+}
+
+void ExternalMerge::add(std::int64_t key, std::uint64_t value) {
+  buffer_.push_back({key, value});
+  if (buffer_.size() < opts_.run_entries) return;
+
+  std::vector<Entry> sealed;
+  sealed.reserve(opts_.run_entries);
+  std::swap(sealed, buffer_);
+  spill(std::move(sealed), runs_++);
+}
+
+void ExternalMerge::spill(std::vector<Entry>&& buf, std::size_t run) {
+  const std::string path = opts_.run_prefix + ".run" + std::to_string(run);
+  auto work = [buf = std::move(buf), path]() mutable {
+    EXYNOS_TRACE_SCOPE("sort.spill_run");
+    std::vector<Entry> scratch;
+    radix_sort(buf, scratch);
+    io::UringWriter out(path);
+    out.write_at(0, buf.data(), buf.size() * sizeof(Entry));
+    out.close();
+  };
+  if (opts_.pool == nullptr) {
+    work();
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mu_);
+    ++pending_spills_;
+  }
+  opts_.pool->submit([this, work = std::move(work)]() mutable {
+    // The spill must count as done whether or not the write succeeded,
+    // or wait_spills() deadlocks; the failure is latched for merge_to.
+    std::exception_ptr error;
+    try {
+      work();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::unique_lock<std::mutex> lock(mu_);
+    if (error != nullptr && spill_error_ == nullptr) spill_error_ = error;
+    if (--pending_spills_ == 0) spills_done_.notify_all();
+  });
+}
+
+void ExternalMerge::wait_spills() const {
+  std::unique_lock<std::mutex> lock(mu_);
+  spills_done_.wait(lock, [this] { return pending_spills_ == 0; });
+}
+
+std::size_t ExternalMerge::run_count() const {
+  std::unique_lock<std::mutex> lock(mu_);
+  return runs_;
+}
+
+std::uint64_t ExternalMerge::merge_to(io::UringWriter& out) {
+  EXYNOS_TRACE_SCOPE("sort.merge");
+  // The in-memory tail sorts inline and merges as one more source; no
+  // point spilling it just to map it back.
+  std::vector<Entry> tail;
+  std::swap(tail, buffer_);
+  {
+    std::vector<Entry> scratch;
+    radix_sort(tail, scratch);
+  }
+  wait_spills();
+  {
+    // The destructor's wait_spills() must stay non-throwing, so a failed
+    // spill surfaces here instead — before the merge maps a run file
+    // that may be short or missing.
+    std::unique_lock<std::mutex> lock(mu_);
+    if (spill_error_ != nullptr)
+      std::rethrow_exception(std::exchange(spill_error_, nullptr));
+  }
+
+  struct Source {
+    const Entry* cur;
+    const Entry* end;
+  };
+  std::vector<jsonl::MmapReader> maps;
+  std::vector<Source> sources;
+  maps.reserve(runs_);
+  for (std::size_t r = 0; r < runs_; ++r) {
+    maps.emplace_back(opts_.run_prefix + ".run" + std::to_string(r));
+    const std::string_view data = maps.back().data();
+    const Entry* base = reinterpret_cast<const Entry*>(data.data());
+    sources.push_back({base, base + data.size() / sizeof(Entry)});
+  }
+  if (!tail.empty()) sources.push_back({tail.data(), tail.data() + tail.size()});
+
+  // Loser tree over the k sources: tree_[0] is the current winner,
+  // tree_[1..k-1] hold the losers of the matches on each leaf's path to
+  // the root, so replacing the winner replays exactly log2(k) matches.
+  const std::size_t k = sources.size();
+  auto source_less = [&](std::size_t x, std::size_t y) {
+    if (sources[x].cur == sources[x].end) return false;  // exhausted = +inf
+    if (sources[y].cur == sources[y].end) return true;
+    return entry_less(*sources[x].cur, *sources[y].cur);
+  };
+  constexpr std::size_t kNone = ~std::size_t{0};
+  std::vector<std::size_t> tree(std::max<std::size_t>(k, 1), kNone);
+  auto replay = [&](std::size_t s) {
+    for (std::size_t t = (s + k) / 2; t > 0; t /= 2) {
+      if (tree[t] == kNone) {  // first build: park at the bye and stop
+        tree[t] = s;
+        return;
+      }
+      if (source_less(tree[t], s)) std::swap(s, tree[t]);
+    }
+    tree[0] = s;
+  };
+  for (std::size_t s = 0; s < k; ++s) replay(s);
+
+  // Stream the winners out in UringWriter-buffer-sized batches.
+  constexpr std::size_t kBatch = (256 * 1024) / sizeof(Entry);
+  std::vector<Entry> batch;
+  batch.reserve(kBatch);
+  std::uint64_t written = 0;
+  auto flush_batch = [&] {
+    out.write_at(written * sizeof(Entry) - batch.size() * sizeof(Entry),
+                 batch.data(), batch.size() * sizeof(Entry));
+    batch.clear();
+  };
+  while (k != 0) {
+    Source& win = sources[tree[0]];
+    if (win.cur == win.end) break;  // every source exhausted
+    batch.push_back(*win.cur++);
+    ++written;
+    if (batch.size() == kBatch) flush_batch();
+    replay(tree[0]);
+  }
+  if (!batch.empty()) flush_batch();
+  out.flush();
+
+  maps.clear();
+  for (std::size_t r = 0; r < runs_; ++r)
+    std::remove((opts_.run_prefix + ".run" + std::to_string(r)).c_str());
+  runs_ = 0;
+  return written;
+}
+
+}  // namespace exynos::sort
@@ -0,0 +1,108 @@
+#include "exynos/trace/trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace exynos::trace {
+
+namespace {
+
+struct Registry {
+  std::mutex mu;
+  std::vector<std::unique_ptr<detail::SiteStats>> all;
+
+  static Registry& instance() {
+    static Registry* r = new Registry;  // leaked: outlives thread exits
+    return *r;
+  }
+};
+
+// Percentile estimate from a log2 histogram: returns the upper bound of
+// the bucket containing the q-th sample.
+std::uint64_t percentile(const std::uint64_t* buckets, std::uint64_t count,
+                         double q) {
+  if (count == 0) return 0;
+  const auto target = static_cast<std::uint64_t>(q * static_cast<double>(count));
+  std::uint64_t seen = 0;
+  for (int b = 0; b < 64; ++b) {
+    seen += buckets[b];
+    if (seen > target)
+      return b >= 63 ? ~std::uint64_t{0} : std::uint64_t{1} << (b + 1);
+  }
+  return ~std::uint64_t{0};
+}
+
+}  // namespace
+
+namespace detail {
+
+SiteStats* site(const char* name) {
+  Registry& reg = Registry::instance();
+  auto stats = std::make_unique<SiteStats>();
+  stats->name = name;
+  SiteStats* raw = stats.get();
+  std::lock_guard<std::mutex> lock(reg.mu);
+  reg.all.push_back(std::move(stats));
+  return raw;
+}
+
+}  // namespace detail
+
+void dump(std::FILE* out) {
+  Registry& reg = Registry::instance();
+  // Aggregate per site name across threads.
+  struct Agg {
+    std::string name;
+    std::uint64_t count = 0, total = 0;
+    std::uint64_t buckets[64] = {};
+  };
+  std::vector<Agg> aggs;
+  {
+    std::lock_guard<std::mutex> lock(reg.mu);
+    for (const auto& s : reg.all) {
+      Agg* agg = nullptr;
+      for (Agg& a : aggs)
+        if (a.name == s->name) agg = &a;
+      if (agg == nullptr) {
+        aggs.push_back({});
+        aggs.back().name = s->name;
+        agg = &aggs.back();
+      }
+      agg->count += s->count;
+      agg->total += s->total;
+      for (int b = 0; b < 64; ++b) agg->buckets[b] += s->buckets[b];
+    }
+  }
+  std::sort(aggs.begin(), aggs.end(),
+            [](const Agg& a, const Agg& b) { return a.total > b.total; });
+
+  std::fprintf(out, "%-32s %12s %16s %10s %10s %10s\n", "site", "count",
+               "total_cycles", "mean", "~p50", "~p99");
+  for (const Agg& a : aggs) {
+    if (a.count == 0) continue;
+    std::fprintf(out, "%-32s %12llu %16llu %10.1f %10llu %10llu\n",
+                 a.name.c_str(), static_cast<unsigned long long>(a.count),
+                 static_cast<unsigned long long>(a.total),
+                 static_cast<double>(a.total) / static_cast<double>(a.count),
+                 static_cast<unsigned long long>(
+                     percentile(a.buckets, a.count, 0.50)),
+                 static_cast<unsigned long long>(
+                     percentile(a.buckets, a.count, 0.99)));
+  }
+}
+
+void reset() {
+  Registry& reg = Registry::instance();
+  std::lock_guard<std::mutex> lock(reg.mu);
+  for (const auto& s : reg.all) {
+    s->count = 0;
+    s->total = 0;
+    std::memset(s->buckets, 0, sizeof(s->buckets));
+  }
+}
+
+}  // namespace exynos::trace
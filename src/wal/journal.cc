@@ -0,0 +1,207 @@
+#include "exynos/wal/journal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+#include "exynos/trace/trace.h"
+
+namespace exynos::wal {
+
+namespace {
+
+[[noreturn]] void throw_errno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+// One frame: header + payload, CRC over offset and payload so a torn or
+// bit-rotted tail never replays.
+struct FrameHeader {
+  std::uint32_t len;  // payload bytes
+  std::uint32_t crc;
+  std::uint64_t offset;  // source-log offset carried through replay
+};
+static_assert(sizeof(FrameHeader) == 16);
+
+std::uint32_t crc32(const void* data, std::size_t len, std::uint32_t seed) {
+  static const std::vector<std::uint32_t> table = [] {
+    std::vector<std::uint32_t> t(256);
+    for (std::uint32_t i = 0; i < 256; ++i) {
+      std::uint32_t c = i;
+      for (int k = 0; k < 8; ++k)
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      t[i] = c;
+    }
+    return t;
+  }();
+  std::uint32_t c = ~seed;
+  const auto* p = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < len; ++i) c = table[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+  return ~c;
+}
+
+std::uint32_t frame_crc(std::uint64_t offset, std::string_view payload) {
+  const std::uint32_t c = crc32(&offset, sizeof(offset), 0);
+  return crc32(payload.data(), payload.size(), c);
+}
+
+}  // namespace
+
+Journal::Journal(JournalOptions opts) : opts_(std::move(opts)) {
+  fd_ = ::open(opts_.path.c_str(), O_CREAT | O_RDWR | O_APPEND | O_CLOEXEC,
+               0644);
+  if (fd_ < 0) throw_errno("open " + opts_.path);
+
+  if (opts_.flush_interval.count() > 0) {
+    flush_thread_ = std::thread([this] {
+      std::unique_lock<std::mutex> lock(mu_);
+      while (!stopping_) {
+        stop_cv_.wait_for(lock, opts_.flush_interval);
+        if (stopping_) return;
+        if (!batch_.empty()) {
+          // No caller to throw to on this thread; latch the errno and
+          // let the next append()/sync() surface it.
+          const int err = commit_locked();
+          if (err != 0 && sticky_errno_ == 0) sticky_errno_ = err;
+        }
+      }
+    });
+  }
+}
+
+Journal::~Journal() {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    stopping_ = true;
+    // Best-effort: a commit failure here has no caller left to hear
+    // about it, and throwing from a destructor is terminate().
+    if (!batch_.empty()) commit_locked();
+  }
+  stop_cv_.notify_all();
+  if (flush_thread_.joinable()) flush_thread_.join();
+  if (fd_ >= 0) ::close(fd_);
+}
+
+std::size_t Journal::replay(
+    const std::function<void(std::string_view, std::uint64_t)>& cb) {
+  EXYNOS_TRACE_SCOPE("wal.replay");
+  // One sequential read of the whole journal; compaction keeps it small.
+  off_t size = ::lseek(fd_, 0, SEEK_END);
+  if (size < 0) throw_errno("lseek " + opts_.path);
+  std::string bytes(static_cast<std::size_t>(size), '\0');
+  std::size_t done = 0;
+  while (done < bytes.size()) {
+    const ssize_t n = ::pread(fd_, bytes.data() + done, bytes.size() - done,
+                              static_cast<off_t>(done));
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      throw_errno("pread " + opts_.path);
+    }
+    if (n == 0) break;
+    done += static_cast<std::size_t>(n);
+  }
+
+  std::size_t pos = 0;
+  std::size_t frames = 0;
+  while (done - pos >= sizeof(FrameHeader)) {
+    FrameHeader header;
+    std::memcpy(&header, bytes.data() + pos, sizeof(header));
+    const std::size_t body = pos + sizeof(header);
+    if (header.len > done - body) break;  // torn mid-payload
+    const std::string_view payload(bytes.data() + body, header.len);
+    if (frame_crc(header.offset, payload) != header.crc) break;
+    cb(payload, header.offset);
+    pos = body + header.len;
+    ++frames;
+  }
+  if (pos != done) {
+    // Drop the torn tail so the next commit appends after intact frames.
+    if (::ftruncate(fd_, static_cast<off_t>(pos)) != 0)
+      throw_errno("ftruncate " + opts_.path);
+  }
+  return frames;
+}
+
+void Journal::append(std::string_view record, std::uint64_t offset) {
+  std::lock_guard<std::mutex> lock(mu_);
+  throw_if_failed_locked();
+  FrameHeader header;
+  header.len = static_cast<std::uint32_t>(record.size());
+  header.offset = offset;
+  header.crc = frame_crc(offset, record);
+  batch_.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  batch_.append(record.data(), record.size());
+  ++appended_;
+  if (batch_.size() >= opts_.flush_bytes) {
+    const int err = commit_locked();
+    if (err != 0)
+      throw std::system_error(err, std::generic_category(),
+                              "journal commit " + opts_.path);
+  }
+}
+
+void Journal::sync() {
+  std::lock_guard<std::mutex> lock(mu_);
+  throw_if_failed_locked();
+  if (batch_.empty()) return;
+  const int err = commit_locked();
+  if (err != 0)
+    throw std::system_error(err, std::generic_category(),
+                            "journal commit " + opts_.path);
+}
+
+int Journal::commit_locked() noexcept {
+  EXYNOS_TRACE_SCOPE("wal.commit");
+  std::size_t done = 0;
+  while (done < batch_.size()) {
+    const ssize_t n = ::write(fd_, batch_.data() + done, batch_.size() - done);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      // Keep the unwritten frames buffered so a transient failure can
+      // still commit them later.
+      batch_.erase(0, done);
+      return errno;
+    }
+    done += static_cast<std::size_t>(n);
+  }
+  if (::fdatasync(fd_) != 0) {
+    // The frames are in the page cache but not durable; re-sending them
+    // would duplicate, so drop the batch and report the errno.
+    batch_.clear();
+    return errno;
+  }
+  batch_.clear();
+  ++commits_;
+  return 0;
+}
+
+void Journal::throw_if_failed_locked() {
+  if (sticky_errno_ == 0) return;
+  const int err = sticky_errno_;
+  sticky_errno_ = 0;
+  throw std::system_error(err, std::generic_category(),
+                          "journal flush " + opts_.path);
+}
+
+void Journal::reset() {
+  std::lock_guard<std::mutex> lock(mu_);
+  batch_.clear();
+  if (::ftruncate(fd_, 0) != 0) throw_errno("ftruncate " + opts_.path);
+  if (::fdatasync(fd_) != 0) throw_errno("fdatasync " + opts_.path);
+}
+
+std::uint64_t Journal::appended() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return appended_;
+}
+
+std::uint64_t Journal::commits() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return commits_;
+}
+
+}  // namespace exynos::wal
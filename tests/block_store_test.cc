@@ -0,0 +1,119 @@
+#include "exynos/cache/block_store.h"
+
+#include <cstdio>
+#include <string>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/jsonl/parser.h"
+#include "exynos/query/engine.h"
+#include "exytest.h"
+
+using exynos::cache::BlockStore;
+using exynos::cache::BlockStoreWriter;
+using exynos::cache::ColumnStore;
+using exynos::cache::ColumnStoreBuilder;
+using exynos::query::CmpOp;
+using exynos::query::Query;
+
+namespace {
+
+constexpr const char* kCol = "block_store_test.exycol";
+constexpr const char* kBlk = "block_store_test.exyblk";
+
+void cleanup() {
+  std::remove(kCol);
+  std::remove(kBlk);
+}
+
+// 64 rows: ts increases monotonically so zone maps partition cleanly
+// across 8-row blocks; every 7th row has no endpoint (null).
+void build_stores() {
+  ColumnStoreBuilder builder;
+  exynos::jsonl::Record rec;
+  for (int i = 0; i < 64; ++i) {
+    std::string line = "{\"endpoint\":\"/api/ep-" + std::to_string(i % 3) +
+                       "\",\"ts\":" + std::to_string(1000 + i * 10) +
+                       ",\"latency_ms\":" + std::to_string(i % 10) + "}";
+    if (i % 7 == 0)
+      line = "{\"ts\":" + std::to_string(1000 + i * 10) +
+             ",\"latency_ms\":" + std::to_string(i % 10) + "}";
+    EXPECT_TRUE(parse_record(line, rec));
+    builder.add(rec);
+  }
+  builder.write(kCol, 0, 0);
+  ColumnStore source(kCol);
+  BlockStoreWriter::write(source, kBlk, {8, exynos::cache::BlockCodec::None});
+}
+
+}  // namespace
+
+TEST(block_file_round_trips_metadata) {
+  cleanup();
+  build_stores();
+  BlockStore blocks(kBlk);
+  EXPECT_EQ(blocks.rows(), 64u);
+  EXPECT_EQ(blocks.blocks(), 8u);
+  EXPECT_EQ(blocks.block_row_count(7), 8u);
+  EXPECT_TRUE(blocks.find_column("ts").has_value());
+  EXPECT_FALSE(blocks.find_column("nope").has_value());
+
+  // Block 0 covers ts 1000..1070.
+  const auto ts = *blocks.find_column("ts");
+  EXPECT_EQ(blocks.chunk(0, ts).min, 1000);
+  EXPECT_EQ(blocks.chunk(0, ts).max, 1070);
+  cleanup();
+}
+
+TEST(zone_maps_skip_blocks_before_decompression) {
+  cleanup();
+  build_stores();
+  BlockStore blocks(kBlk);
+
+  Query q;
+  q.filters.push_back({"ts", CmpOp::Ge, 1000 + 56 * 10, ""});
+  auto result = run_blocks(blocks, q);
+  // Only the last block overlaps [1560, ...): 7 skipped, 8 rows scanned.
+  EXPECT_EQ(result.blocks_skipped, 7u);
+  EXPECT_EQ(result.rows_scanned, 8u);
+  EXPECT_EQ(result.rows_selected, 8u);
+  cleanup();
+}
+
+TEST(block_results_match_uncompressed_engine) {
+  cleanup();
+  build_stores();
+  ColumnStore source(kCol);
+  BlockStore blocks(kBlk);
+
+  Query q;
+  q.filters.push_back({"latency_ms", CmpOp::Gt, 4, ""});
+  q.group_by = "endpoint";
+  const auto expect = exynos::query::Engine(source).run(q);
+  const auto got = run_blocks(blocks, q);
+  EXPECT_EQ(got.rows_selected, expect.rows_selected);
+  EXPECT_EQ(got.groups.size(), expect.groups.size());
+  for (std::size_t i = 0; i < expect.groups.size(); ++i) {
+    EXPECT_EQ(got.groups[i].key, expect.groups[i].key);
+    EXPECT_EQ(got.groups[i].value, expect.groups[i].value);
+  }
+  cleanup();
+}
+
+TEST(string_eq_absent_from_block_dictionary) {
+  cleanup();
+  build_stores();
+  BlockStore blocks(kBlk);
+
+  Query q;
+  q.filters.push_back({"endpoint", CmpOp::Eq, 0, "/api/ep-1"});
+  q.filters.push_back({"ts", CmpOp::Lt, 1080, ""});
+  auto result = run_blocks(blocks, q);
+  // Block 0: rows 1,4,7 (i%3==1) minus row 7, whose endpoint is null.
+  EXPECT_EQ(result.blocks_skipped, 7u);
+  EXPECT_EQ(result.rows_selected, 2u);
+
+  Query absent;
+  absent.filters.push_back({"endpoint", CmpOp::Eq, 0, "/api/ep-9"});
+  EXPECT_EQ(run_blocks(blocks, absent).rows_selected, 0u);
+  cleanup();
+}
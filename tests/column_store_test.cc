@@ -0,0 +1,147 @@
+#include "exynos/cache/column_store.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "exytest.h"
+
+using exynos::cache::ColumnStore;
+using exynos::cache::ColumnStoreBuilder;
+using exynos::cache::ColumnType;
+using exynos::jsonl::parse_record;
+using exynos::jsonl::Record;
+
+namespace {
+
+constexpr const char* kCache = "column_store_test.exycol";
+
+void build_sample(const char* path) {
+  ColumnStoreBuilder builder;
+  Record rec;
+  const char* lines[] = {
+      R"({"id":"a","endpoint":"/users","latency_ms":10,"ok":true})",
+      R"({"id":"b","endpoint":"/orders","latency_ms":250,"ok":false})",
+      R"({"id":"c","endpoint":"/users","latency_ms":7})",
+  };
+  for (const char* line : lines) {
+    EXPECT_TRUE(parse_record(line, rec));
+    builder.add(rec);
+  }
+  builder.write(path, 1234, 5678);
+}
+
+}  // namespace
+
+TEST(round_trips_typed_columns) {
+  build_sample(kCache);
+  ColumnStore store(kCache);
+  EXPECT_EQ(store.rows(), 3u);
+
+  auto latency = store.find("latency_ms");
+  EXPECT_TRUE(latency.has_value());
+  EXPECT_EQ(latency->type(), ColumnType::Int64);
+  EXPECT_EQ(latency->ints()[0], 10);
+  EXPECT_EQ(latency->ints()[1], 250);
+  EXPECT_EQ(latency->ints()[2], 7);
+
+  auto ok = store.find("ok");
+  EXPECT_EQ(ok->type(), ColumnType::Bool);
+  EXPECT_EQ(ok->bools()[0], 1);
+  EXPECT_EQ(ok->bools()[1], 0);
+  std::remove(kCache);
+}
+
+TEST(strings_are_dictionary_encoded) {
+  build_sample(kCache);
+  ColumnStore store(kCache);
+  auto endpoint = store.find("endpoint");
+  EXPECT_EQ(endpoint->type(), ColumnType::String);
+  EXPECT_EQ(endpoint->dict_size(), 2u);  // "/users" shared by rows 0 and 2
+  EXPECT_EQ(endpoint->codes()[0], endpoint->codes()[2]);
+  EXPECT_EQ(endpoint->str(0), "/users");
+  EXPECT_EQ(endpoint->str(1), "/orders");
+  std::remove(kCache);
+}
+
+TEST(missing_fields_are_null) {
+  build_sample(kCache);
+  ColumnStore store(kCache);
+  auto ok = store.find("ok");
+  EXPECT_TRUE(ok->is_valid(0));
+  EXPECT_TRUE(ok->is_valid(1));
+  EXPECT_FALSE(ok->is_valid(2));  // third record has no "ok"
+  std::remove(kCache);
+}
+
+TEST(column_payloads_are_64_byte_aligned) {
+  build_sample(kCache);
+  ColumnStore store(kCache);
+  for (std::uint32_t i = 0; i < store.columns(); ++i) {
+    auto col = store.at(i);
+    if (col.type() == ColumnType::Int64)
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(col.ints()) % 64, 0u);
+  }
+  std::remove(kCache);
+}
+
+TEST(staleness_tracks_source_identity) {
+  build_sample(kCache);
+  EXPECT_TRUE(ColumnStore::up_to_date(kCache, 1234, 5678));
+  EXPECT_FALSE(ColumnStore::up_to_date(kCache, 1235, 5678));
+  EXPECT_FALSE(ColumnStore::up_to_date(kCache, 1234, 9999));
+  EXPECT_FALSE(ColumnStore::up_to_date("no_such.exycol", 1234, 5678));
+  std::remove(kCache);
+}
+
+TEST(open_or_build_builds_then_reuses) {
+  const char* jsonl = "column_store_test.tmp.jsonl";
+  {
+    std::ofstream out(jsonl, std::ios::binary);
+    out << R"({"id":"x","latency_ms":1})" << "\n"
+        << R"({"id":"y","latency_ms":2})" << "\n";
+  }
+  {
+    auto store = exynos::cache::open_or_build(jsonl, kCache);
+    EXPECT_EQ(store.rows(), 2u);
+  }
+  // Second open must hit the cache (file unchanged).
+  auto store = exynos::cache::open_or_build(jsonl, kCache);
+  EXPECT_EQ(store.rows(), 2u);
+  EXPECT_EQ(store.find("id")->str(1), "y");
+  std::remove(jsonl);
+  std::remove(kCache);
+}
+
+TEST(id_index_embedded_and_mapped) {
+  const char* jsonl = "column_store_test.tmp.jsonl";
+  {
+    std::ofstream out(jsonl, std::ios::binary);
+    out << R"({"id":"x","latency_ms":1})" << "\n"     // offset 0
+        << R"({"id":"y","latency_ms":2})" << "\n";    // offset 26
+  }
+  auto store = exynos::cache::open_or_build(jsonl, kCache);
+  auto index = store.id_index();
+  EXPECT_TRUE(index.has_value());
+  EXPECT_TRUE(index->is_view());
+  EXPECT_EQ(*index->find("x"), 0u);
+  EXPECT_EQ(*index->find("y"), 26u);
+  EXPECT_FALSE(index->find("z").has_value());
+  std::remove(jsonl);
+  std::remove(kCache);
+}
+
+TEST(corrupt_file_rejected) {
+  {
+    std::ofstream out(kCache, std::ios::binary);
+    out << "definitely not a column store";
+  }
+  bool threw = false;
+  try {
+    ColumnStore store(kCache);
+  } catch (const std::exception&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+  std::remove(kCache);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+// Minimal single-header test harness. Each test binary links exytest_main.cc
+// which runs every TEST() in registration order and exits nonzero on the
+// first batch of failures. Intentionally tiny: no fixtures, no deps.
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace exytest {
+
+struct Case {
+  const char* name;
+  std::function<void()> fn;
+};
+
+inline std::vector<Case>& registry() {
+  static std::vector<Case> cases;
+  return cases;
+}
+
+inline int& failures() {
+  static int n = 0;
+  return n;
+}
+
+struct Registrar {
+  Registrar(const char* name, std::function<void()> fn) {
+    registry().push_back({name, std::move(fn)});
+  }
+};
+
+inline int run_all() {
+  for (const Case& c : registry()) {
+    int before = failures();
+    c.fn();
+    std::printf("[%s] %s\n", failures() == before ? " OK " : "FAIL", c.name);
+  }
+  if (failures() != 0) {
+    std::printf("%d check(s) failed\n", failures());
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace exytest
+
+#define TEST(name)                                             \
+  static void exytest_##name();                                \
+  static ::exytest::Registrar exytest_reg_##name(#name,        \
+                                                 exytest_##name); \
+  static void exytest_##name()
+
+#define EXPECT_TRUE(cond)                                                 \
+  do {                                                                    \
+    if (!(cond)) {                                                        \
+      std::printf("%s:%d: EXPECT_TRUE(%s) failed\n", __FILE__, __LINE__,  \
+                  #cond);                                                 \
+      ++::exytest::failures();                                            \
+    }                                                                     \
+  } while (0)
+
+#define EXPECT_FALSE(cond) EXPECT_TRUE(!(cond))
+
+#define EXPECT_EQ(a, b)                                                    \
+  do {                                                                     \
+    if (!((a) == (b))) {                                                   \
+      std::printf("%s:%d: EXPECT_EQ(%s, %s) failed\n", __FILE__, __LINE__, \
+                  #a, #b);                                                 \
+      ++::exytest::failures();                                             \
+    }                                                                      \
+  } while (0)
+
+#define EXPECT_NE(a, b)                                                    \
+  do {                                                                     \
+    if ((a) == (b)) {                                                      \
+      std::printf("%s:%d: EXPECT_NE(%s, %s) failed\n", __FILE__, __LINE__, \
+                  #a, #b);                                                 \
+      ++::exytest::failures();                                             \
+    }                                                                      \
+  } while (0)
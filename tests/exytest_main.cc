@@ -0,0 +1,3 @@
+#include "exytest.h"
+
+int main() { return exytest::run_all(); }
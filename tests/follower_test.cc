@@ -0,0 +1,90 @@
+#include "exynos/ingest/follower.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "exytest.h"
+
+using exynos::ingest::Follower;
+
+namespace {
+
+constexpr const char* kLog = "follower_test.tmp.jsonl";
+
+void append(const char* path, const std::string& bytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::app);
+  out << bytes;
+}
+
+}  // namespace
+
+TEST(emits_records_appended_after_open) {
+  std::remove(kLog);
+  append(kLog, "{\"id\":\"a\"}\n");
+  std::vector<std::string> seen;
+  Follower follower(kLog, [&](std::string_view rec, std::uint64_t) {
+    seen.emplace_back(rec);
+  });
+  follower.poll_once();  // catch-up pass
+  EXPECT_EQ(seen.size(), 1u);
+
+  append(kLog, "{\"id\":\"b\"}\n{\"id\":\"c\"}\n");
+  follower.poll_once();
+  EXPECT_EQ(seen.size(), 3u);
+  EXPECT_EQ(seen[2], "{\"id\":\"c\"}");
+  std::remove(kLog);
+}
+
+TEST(torn_final_line_held_until_complete) {
+  std::remove(kLog);
+  append(kLog, "{\"id\":\"a\"}\n{\"id\":\"b\"");  // no trailing newline
+  std::vector<std::string> seen;
+  Follower follower(kLog, [&](std::string_view rec, std::uint64_t) {
+    seen.emplace_back(rec);
+  });
+  follower.poll_once();
+  EXPECT_EQ(seen.size(), 1u);
+
+  append(kLog, "}\n");  // complete the torn record
+  follower.poll_once();
+  EXPECT_EQ(seen.size(), 2u);
+  EXPECT_EQ(seen[1], "{\"id\":\"b\"}");
+  std::remove(kLog);
+}
+
+TEST(offsets_track_file_positions) {
+  std::remove(kLog);
+  append(kLog, "{\"a\":1}\n{\"b\":2}\n");
+  std::vector<std::uint64_t> offsets;
+  Follower follower(kLog, [&](std::string_view, std::uint64_t off) {
+    offsets.push_back(off);
+  });
+  follower.poll_once();
+  EXPECT_EQ(offsets.size(), 2u);
+  EXPECT_EQ(offsets[0], 0u);
+  EXPECT_EQ(offsets[1], 8u);
+  EXPECT_EQ(follower.processed_bytes(), 16u);
+  std::remove(kLog);
+}
+
+TEST(rotation_switches_to_new_inode) {
+  std::remove(kLog);
+  append(kLog, "{\"gen\":1}\n");
+  std::vector<std::string> seen;
+  Follower follower(kLog, [&](std::string_view rec, std::uint64_t) {
+    seen.emplace_back(rec);
+  });
+  follower.poll_once();
+  EXPECT_EQ(seen.size(), 1u);
+
+  std::rename(kLog, "follower_test.rotated.jsonl");
+  append(kLog, "{\"gen\":2}\n");  // new file at the watched path
+  follower.poll_once();
+  EXPECT_EQ(seen.size(), 2u);
+  EXPECT_EQ(seen[1], "{\"gen\":2}");
+  EXPECT_EQ(follower.processed_bytes(), 10u);  // offset reset for new file
+  std::remove(kLog);
+  std::remove("follower_test.rotated.jsonl");
+}
@@ -0,0 +1,142 @@
+#include "exynos/sched/governor.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+#include "exynos/sched/steal_pool.h"
+#include "exytest.h"
+
+using exynos::sched::Governor;
+using exynos::sched::GovernorOptions;
+
+namespace {
+
+constexpr const char* kRoot = "governor_test_thermal";
+
+void write_file(const std::string& path, const std::string& body) {
+  std::FILE* f = std::fopen(path.c_str(), "w");
+  EXPECT_TRUE(f != nullptr);
+  std::fputs(body.c_str(), f);
+  std::fclose(f);
+}
+
+// One zone with a passive trip at 70C; `temp` is rewritten per test step.
+void build_fake_zone(long temp_millic) {
+  ::mkdir(kRoot, 0755);
+  const std::string zone = std::string(kRoot) + "/thermal_zone0";
+  ::mkdir(zone.c_str(), 0755);
+  write_file(zone + "/temp", std::to_string(temp_millic) + "\n");
+  write_file(zone + "/trip_point_0_temp", "70000\n");
+  write_file(zone + "/trip_point_0_type", "passive\n");
+}
+
+void set_temp(long temp_millic) {
+  write_file(std::string(kRoot) + "/thermal_zone0/temp",
+             std::to_string(temp_millic) + "\n");
+}
+
+void remove_fake_zone() {
+  const std::string zone = std::string(kRoot) + "/thermal_zone0";
+  for (const char* f :
+       {"/temp", "/trip_point_0_temp", "/trip_point_0_type"})
+    std::remove((zone + f).c_str());
+  ::rmdir(zone.c_str());
+  ::rmdir(kRoot);
+}
+
+GovernorOptions manual_opts() {
+  GovernorOptions opts;
+  opts.thermal_root = kRoot;
+  opts.cpu_root = "governor_test_no_cpus";  // no cpufreq: never "clamped"
+  opts.poll_interval = std::chrono::milliseconds(0);  // drive poll_now()
+  opts.max_workers = 8;
+  return opts;
+}
+
+}  // namespace
+
+TEST(cool_chip_ramps_to_full_budget) {
+  build_fake_zone(40000);
+  Governor gov(manual_opts());
+  EXPECT_EQ(gov.trip_millic(), 70000);
+  EXPECT_EQ(gov.max_temp_millic(), 40000);
+  for (int i = 0; i < 10; ++i) gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), 8u);
+  EXPECT_FALSE(gov.throttled());
+  remove_fake_zone();
+}
+
+TEST(headroom_band_eases_off_one_per_poll) {
+  build_fake_zone(67000);  // inside [trip - headroom, trip)
+  Governor gov(manual_opts());
+  const unsigned before = gov.background_limit();
+  gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), before - 1);
+  remove_fake_zone();
+}
+
+TEST(over_trip_halves_and_recovery_is_additive) {
+  build_fake_zone(40000);
+  Governor gov(manual_opts());
+  for (int i = 0; i < 10; ++i) gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), 8u);
+
+  set_temp(75000);
+  gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), 4u);
+  gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), 2u);
+
+  set_temp(40000);
+  gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), 3u);  // +1, not a jump back to 8
+  remove_fake_zone();
+}
+
+TEST(limit_never_drops_below_min_workers) {
+  build_fake_zone(90000);
+  GovernorOptions opts = manual_opts();
+  opts.min_workers = 2;
+  Governor gov(opts);
+  for (int i = 0; i < 10; ++i) gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), 2u);
+  remove_fake_zone();
+}
+
+TEST(missing_zones_assume_default_trip) {
+  GovernorOptions opts = manual_opts();
+  opts.thermal_root = "governor_test_nonexistent";
+  Governor gov(opts);
+  EXPECT_EQ(gov.trip_millic(), opts.default_trip_millic);
+  EXPECT_EQ(gov.max_temp_millic(), -1);
+  // No temperature signal: budget ramps to max rather than starving work.
+  for (int i = 0; i < 10; ++i) gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), opts.max_workers);
+}
+
+TEST(paced_parallel_for_respects_budget) {
+  build_fake_zone(90000);  // pins the budget at min_workers = 1
+  Governor gov(manual_opts());
+  for (int i = 0; i < 10; ++i) gov.poll_now();
+  EXPECT_EQ(gov.background_limit(), 1u);
+
+  exynos::sched::StealPool pool(4);
+  std::atomic<int> running{0};
+  std::atomic<int> peak{0};
+  std::atomic<int> total{0};
+  gov.parallel_for_paced(pool, 2000, [&](std::size_t) {
+    const int now = running.fetch_add(1) + 1;
+    int expect = peak.load();
+    while (now > expect && !peak.compare_exchange_weak(expect, now)) {
+    }
+    total.fetch_add(1);
+    running.fetch_sub(1);
+  });
+  EXPECT_EQ(total.load(), 2000);
+  EXPECT_EQ(peak.load(), 1);
+  remove_fake_zone();
+}
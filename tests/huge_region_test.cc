@@ -0,0 +1,66 @@
+#include "exynos/mem/huge_region.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/index/id_map.h"
+#include "exynos/jsonl/parser.h"
+#include "exytest.h"
+
+using exynos::mem::HugeRegion;
+
+TEST(allocates_writable_memory) {
+  HugeRegion region(1 << 20);
+  EXPECT_TRUE(region.size() >= std::size_t{1} << 20);
+  std::memset(region.data(), 0xAB, region.size());
+  EXPECT_EQ(static_cast<unsigned char>(region.data()[region.size() - 1]),
+            0xABu);
+  // Whatever backing the host granted, touched pages should be resident.
+  EXPECT_TRUE(region.resident_bytes() > 0);
+}
+
+TEST(lock_option_is_best_effort) {
+  // RLIMIT_MEMLOCK may forbid locking here; the region must still work.
+  HugeRegion region(1 << 16, {.lock = true});
+  std::memset(region.data(), 1, 1 << 16);
+  EXPECT_TRUE(region.resident_bytes() > 0);
+}
+
+TEST(move_transfers_ownership) {
+  HugeRegion a(1 << 16);
+  std::memset(a.data(), 7, 64);
+  char* data = a.data();
+  HugeRegion b(std::move(a));
+  EXPECT_TRUE(b.data() == data);
+  EXPECT_TRUE(a.data() == nullptr);
+  EXPECT_EQ(b.data()[63], 7);
+}
+
+TEST(pins_id_index_into_region) {
+  constexpr const char* kPath = "huge_region_test.exycol";
+  exynos::cache::ColumnStoreBuilder builder;
+  exynos::index::IdMap ids;
+  exynos::jsonl::Record rec;
+  for (int i = 0; i < 500; ++i) {
+    const std::string id = "req-" + std::to_string(i);
+    const std::string line = "{\"id\":\"" + id + "\",\"n\":" +
+                             std::to_string(i) + "}";
+    EXPECT_TRUE(parse_record(line, rec));
+    builder.add(rec);
+    ids.insert(id, static_cast<std::uint64_t>(i) * 100);
+  }
+  builder.set_id_index(ids);
+  builder.write(kPath, 0, 0);
+
+  exynos::cache::ColumnStore store(kPath);
+  EXPECT_TRUE(store.id_index_bytes() > 0);
+  HugeRegion region(store.id_index_bytes());
+  auto pinned = store.id_index_pinned(region);
+  EXPECT_TRUE(pinned.has_value());
+  EXPECT_EQ(*pinned->find("req-123"), 12300u);
+  EXPECT_FALSE(pinned->find("req-500").has_value());
+  std::remove(kPath);
+}
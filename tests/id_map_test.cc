@@ -0,0 +1,136 @@
+#include "exynos/index/id_map.h"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "exytest.h"
+
+using exynos::index::IdMap;
+
+TEST(insert_and_find) {
+  IdMap map;
+  map.insert("req-1", 0);
+  map.insert("req-2", 100);
+  map.insert("req-3", 250);
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_EQ(*map.find("req-2"), 100u);
+  EXPECT_EQ(*map.find("req-3"), 250u);
+  EXPECT_FALSE(map.find("req-4").has_value());
+}
+
+TEST(duplicate_id_last_write_wins) {
+  IdMap map;
+  map.insert("req-1", 10);
+  map.insert("req-1", 20);
+  EXPECT_EQ(map.size(), 1u);
+  EXPECT_EQ(*map.find("req-1"), 20u);
+}
+
+TEST(survives_growth_at_volume) {
+  IdMap map;
+  constexpr int kN = 50000;
+  for (int i = 0; i < kN; ++i)
+    map.insert("req-" + std::to_string(i), static_cast<std::uint64_t>(i) * 7);
+  EXPECT_EQ(map.size(), static_cast<std::uint64_t>(kN));
+  for (int i = 0; i < kN; ++i) {
+    auto hit = map.find("req-" + std::to_string(i));
+    EXPECT_TRUE(hit.has_value());
+    if (hit) EXPECT_EQ(*hit, static_cast<std::uint64_t>(i) * 7);
+  }
+  EXPECT_FALSE(map.find("req-" + std::to_string(kN)).has_value());
+}
+
+TEST(reserve_avoids_growth) {
+  IdMap map;
+  map.reserve(1000);
+  const std::uint64_t cap = map.capacity();
+  for (int i = 0; i < 1000; ++i)
+    map.insert("req-" + std::to_string(i), static_cast<std::uint64_t>(i));
+  EXPECT_EQ(map.capacity(), cap);
+}
+
+TEST(serialized_image_reattaches_as_view) {
+  IdMap map;
+  for (int i = 0; i < 2000; ++i)
+    map.insert("req-" + std::to_string(i), static_cast<std::uint64_t>(i));
+  std::vector<std::uint8_t> image = map.serialize();
+
+  IdMap view = IdMap::view(image.data(), image.size());
+  EXPECT_TRUE(view.is_view());
+  EXPECT_EQ(view.size(), map.size());
+  for (int i = 0; i < 2000; ++i)
+    EXPECT_EQ(*view.find("req-" + std::to_string(i)),
+              static_cast<std::uint64_t>(i));
+  EXPECT_FALSE(view.find("absent").has_value());
+}
+
+TEST(batch_lookup_matches_scalar_find) {
+  IdMap map;
+  constexpr int kN = 10000;
+  for (int i = 0; i < kN; ++i)
+    map.insert("req-" + std::to_string(i), static_cast<std::uint64_t>(i) * 3);
+
+  std::vector<std::string> storage;
+  std::vector<std::string_view> ids;
+  for (int i = 0; i < kN + 100; ++i)  // tail 100 are misses
+    storage.push_back("req-" + std::to_string(i));
+  for (const std::string& s : storage) ids.push_back(s);
+
+  std::vector<std::uint64_t> offsets(ids.size());
+  map.lookup_batch(ids, offsets);
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    auto hit = map.find(ids[i]);
+    EXPECT_EQ(offsets[i], hit ? *hit : IdMap::kNotFound);
+  }
+}
+
+TEST(batch_lookup_on_empty_map_all_misses) {
+  IdMap map;
+  std::vector<std::uint64_t> hashes = {1, 2, 3};
+  std::vector<std::uint64_t> offsets(3, 0);
+  map.lookup_batch_hash(hashes, offsets);
+  for (std::uint64_t o : offsets) EXPECT_EQ(o, IdMap::kNotFound);
+}
+
+TEST(batch_lookup_rejects_mismatched_spans) {
+  IdMap map;
+  map.insert("req-1", 0);
+  std::vector<std::uint64_t> hashes(4);
+  std::vector<std::uint64_t> offsets(3);
+  bool threw = false;
+  try {
+    map.lookup_batch_hash(hashes, offsets);
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+}
+
+TEST(batch_lookup_works_on_view) {
+  IdMap map;
+  for (int i = 0; i < 3000; ++i)
+    map.insert("req-" + std::to_string(i), static_cast<std::uint64_t>(i));
+  std::vector<std::uint8_t> image = map.serialize();
+  IdMap view = IdMap::view(image.data(), image.size());
+
+  std::vector<std::uint64_t> hashes;
+  for (int i = 0; i < 3000; ++i)
+    hashes.push_back(IdMap::hash("req-" + std::to_string(i)));
+  std::vector<std::uint64_t> offsets(hashes.size());
+  view.lookup_batch_hash(hashes, offsets);
+  for (std::size_t i = 0; i < offsets.size(); ++i)
+    EXPECT_EQ(offsets[i], static_cast<std::uint64_t>(i));
+}
+
+TEST(corrupt_image_rejected) {
+  std::vector<std::uint8_t> junk(128, 0xAB);
+  bool threw = false;
+  try {
+    IdMap::view(junk.data(), junk.size());
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+}
@@ -0,0 +1,144 @@
+#include "exynos/ingest/live_store.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "exytest.h"
+
+using exynos::ingest::LiveStore;
+using exynos::query::AggOp;
+using exynos::query::CmpOp;
+using exynos::query::Query;
+
+namespace {
+
+constexpr const char* kLog = "live_store_test.tmp.jsonl";
+constexpr const char* kCache = "live_store_test.exycol";
+
+void cleanup() {
+  std::remove(kLog);
+  std::remove(kCache);
+  for (int i = 0; i < 8; ++i)
+    std::remove((std::string(kCache) + ".seg" + std::to_string(i)).c_str());
+}
+
+void write_base() {
+  std::ofstream out(kLog, std::ios::binary);
+  out << R"({"id":"base-1","endpoint":"/a","latency_ms":10})" << "\n"
+      << R"({"id":"base-2","endpoint":"/b","latency_ms":20})" << "\n";
+}
+
+LiveStore::Options opts_with_threshold(std::uint64_t threshold) {
+  LiveStore::Options opts;
+  opts.jsonl_path = kLog;
+  opts.cache_path = kCache;
+  opts.compact_threshold = threshold;
+  return opts;
+}
+
+std::string delta_line(int i) {
+  return "{\"id\":\"live-" + std::to_string(i) +
+         "\",\"endpoint\":\"/a\",\"latency_ms\":" + std::to_string(100 + i) +
+         "}";
+}
+
+}  // namespace
+
+TEST(appends_visible_without_rebuild) {
+  cleanup();
+  write_base();
+  LiveStore store(opts_with_threshold(100000));
+  EXPECT_EQ(store.base_rows(), 2u);
+  EXPECT_EQ(*store.find("base-1"), 0u);
+
+  store.append(delta_line(1), 500);
+  EXPECT_EQ(store.delta_rows(), 1u);
+  EXPECT_EQ(*store.find("live-1"), 500u);
+  EXPECT_FALSE(store.find("live-2").has_value());
+  cleanup();
+}
+
+TEST(queries_union_delta_with_base) {
+  cleanup();
+  write_base();
+  LiveStore store(opts_with_threshold(100000));
+  for (int i = 0; i < 10; ++i)
+    store.append(delta_line(i), 500 + static_cast<std::uint64_t>(i) * 50);
+
+  Query q;
+  q.group_by = "endpoint";
+  auto result = store.run(q);
+  // /a: 1 base + 10 delta, /b: 1 base.
+  EXPECT_EQ(result.groups.size(), 2u);
+  EXPECT_EQ(result.groups[0].key, "/a");
+  EXPECT_EQ(result.groups[0].value, 11);
+  EXPECT_EQ(result.groups[1].value, 1);
+
+  Query max;
+  max.agg = AggOp::Max;
+  max.agg_column = "latency_ms";
+  auto m = store.run(max);
+  EXPECT_EQ(m.groups[0].value, 109);
+  cleanup();
+}
+
+TEST(threshold_seals_delta_into_segment) {
+  cleanup();
+  write_base();
+  LiveStore store(opts_with_threshold(5));
+  for (int i = 0; i < 5; ++i)
+    store.append(delta_line(i), static_cast<std::uint64_t>(i));
+  EXPECT_EQ(store.segment_count(), 1u);
+  EXPECT_EQ(store.delta_rows(), 0u);
+  // Sealed rows stay visible through the segment's own index.
+  EXPECT_EQ(*store.find("live-3"), 3u);
+
+  Query q;
+  q.filters.push_back({"latency_ms", CmpOp::Ge, 100, ""});
+  EXPECT_EQ(store.run(q).rows_selected, 5u);
+  cleanup();
+}
+
+TEST(segments_reattach_on_restart) {
+  cleanup();
+  write_base();
+  {
+    LiveStore store(opts_with_threshold(3));
+    for (int i = 0; i < 6; ++i)
+      store.append(delta_line(i), static_cast<std::uint64_t>(i));
+    EXPECT_EQ(store.segment_count(), 2u);
+  }
+  LiveStore reopened(opts_with_threshold(3));
+  EXPECT_EQ(reopened.segment_count(), 2u);
+  EXPECT_EQ(*reopened.find("live-5"), 5u);
+  cleanup();
+}
+
+TEST(window_queries_prune_out_of_range_segments) {
+  cleanup();
+  std::ofstream out(kLog, std::ios::binary);
+  for (int i = 0; i < 20; ++i)
+    out << "{\"id\":\"base-" << i << "\",\"endpoint\":\"/a\",\"ts\":"
+        << 1000 + i << "}\n";
+  out.close();
+
+  LiveStore store(opts_with_threshold(10));
+  // Two sealed segments covering ts 2000-2009 and 2010-2019.
+  for (int i = 0; i < 20; ++i)
+    store.append("{\"id\":\"live-" + std::to_string(i) +
+                     "\",\"endpoint\":\"/b\",\"ts\":" + std::to_string(2000 + i) +
+                     "}",
+                 static_cast<std::uint64_t>(i));
+  EXPECT_EQ(store.segment_count(), 2u);
+
+  Query q;
+  q.filters.push_back({"ts", CmpOp::Ge, 2010, ""});
+  q.filters.push_back({"ts", CmpOp::Le, 2019, ""});
+  auto r = store.run(q);
+  EXPECT_EQ(r.rows_selected, 10u);
+  // The base and the first segment fall outside the window entirely.
+  EXPECT_EQ(r.rows_scanned, 10u);
+  EXPECT_EQ(r.rows_pruned, 30u);
+  cleanup();
+}
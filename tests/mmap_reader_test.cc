@@ -0,0 +1,81 @@
+#include "exynos/jsonl/mmap_reader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "exytest.h"
+
+namespace {
+
+std::string write_temp(const std::string& contents) {
+  std::string path = "mmap_reader_test.tmp.jsonl";
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << contents;
+  return path;
+}
+
+std::vector<std::string> collect(const exynos::jsonl::MmapReader& reader) {
+  std::vector<std::string> records;
+  for (std::string_view rec : reader) records.emplace_back(rec);
+  return records;
+}
+
+}  // namespace
+
+TEST(yields_each_line_without_newline) {
+  auto path = write_temp("{\"a\":1}\n{\"b\":2}\n{\"c\":3}\n");
+  exynos::jsonl::MmapReader reader(path);
+  auto records = collect(reader);
+  EXPECT_EQ(records.size(), 3u);
+  EXPECT_EQ(records[0], "{\"a\":1}");
+  EXPECT_EQ(records[2], "{\"c\":3}");
+  std::remove(path.c_str());
+}
+
+TEST(final_line_without_trailing_newline) {
+  auto path = write_temp("{\"a\":1}\n{\"b\":2}");
+  exynos::jsonl::MmapReader reader(path);
+  auto records = collect(reader);
+  EXPECT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[1], "{\"b\":2}");
+  std::remove(path.c_str());
+}
+
+TEST(skips_blank_lines) {
+  auto path = write_temp("\n{\"a\":1}\n\n\n{\"b\":2}\n");
+  exynos::jsonl::MmapReader reader(path);
+  auto records = collect(reader);
+  EXPECT_EQ(records.size(), 2u);
+  std::remove(path.c_str());
+}
+
+TEST(empty_file_yields_no_records) {
+  auto path = write_temp("");
+  exynos::jsonl::MmapReader reader(path);
+  EXPECT_EQ(reader.size(), 0u);
+  EXPECT_TRUE(collect(reader).empty());
+  std::remove(path.c_str());
+}
+
+TEST(missing_file_throws) {
+  bool threw = false;
+  try {
+    exynos::jsonl::MmapReader reader("definitely/not/here.jsonl");
+  } catch (const std::system_error&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+}
+
+TEST(views_are_zero_copy_slices_of_mapping) {
+  auto path = write_temp("{\"a\":1}\n{\"b\":2}\n");
+  exynos::jsonl::MmapReader reader(path);
+  std::string_view whole = reader.data();
+  for (std::string_view rec : reader) {
+    EXPECT_TRUE(rec.data() >= whole.data());
+    EXPECT_TRUE(rec.data() + rec.size() <= whole.data() + whole.size());
+  }
+  std::remove(path.c_str());
+}
@@ -0,0 +1,78 @@
+#include "exynos/queue/mpsc_ring.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "exytest.h"
+
+using exynos::queue::MpscRing;
+
+TEST(push_then_batched_pop_preserves_fifo) {
+  MpscRing<int> ring(8);
+  for (int i = 0; i < 5; ++i) EXPECT_TRUE(ring.try_push(int(i)));
+  std::vector<int> out;
+  EXPECT_EQ(ring.pop_batch(out, 3), 3u);
+  EXPECT_EQ(ring.pop_batch(out, 10), 2u);
+  EXPECT_EQ(out.size(), 5u);
+  for (int i = 0; i < 5; ++i) EXPECT_EQ(out[static_cast<std::size_t>(i)], i);
+}
+
+TEST(full_ring_rejects_push_until_drained) {
+  MpscRing<int> ring(4);
+  EXPECT_EQ(ring.capacity(), 4u);
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.try_push(int(i)));
+  EXPECT_FALSE(ring.try_push(99));
+  std::vector<int> out;
+  ring.pop_batch(out, 1);
+  EXPECT_TRUE(ring.try_push(99));
+}
+
+TEST(move_only_elements_supported) {
+  MpscRing<std::unique_ptr<int>> ring(4);
+  EXPECT_TRUE(ring.try_push(std::make_unique<int>(7)));
+  std::vector<std::unique_ptr<int>> out;
+  EXPECT_EQ(ring.pop_batch(out, 4), 1u);
+  EXPECT_EQ(*out[0], 7);
+}
+
+TEST(undrained_elements_destroyed_with_ring) {
+  auto payload = std::make_shared<int>(1);
+  {
+    MpscRing<std::shared_ptr<int>> ring(4);
+    ring.try_push(std::shared_ptr<int>(payload));
+    ring.try_push(std::shared_ptr<int>(payload));
+    EXPECT_EQ(payload.use_count(), 3);
+  }
+  EXPECT_EQ(payload.use_count(), 1);
+}
+
+TEST(concurrent_producers_lose_nothing) {
+  constexpr int kProducers = 4;
+  constexpr int kPerProducer = 5000;
+  MpscRing<int> ring(64);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&ring, p] {
+      for (int i = 0; i < kPerProducer; ++i) {
+        int v = p * kPerProducer + i;
+        while (!ring.try_push(int(v))) std::this_thread::yield();
+      }
+    });
+  }
+  std::vector<int> out;
+  out.reserve(kProducers * kPerProducer);
+  while (out.size() < kProducers * kPerProducer) {
+    if (ring.pop_batch(out, 32) == 0) std::this_thread::yield();
+  }
+  for (auto& t : producers) t.join();
+
+  std::vector<bool> seen(kProducers * kPerProducer, false);
+  bool dup = false;
+  for (int v : out) {
+    if (seen[static_cast<std::size_t>(v)]) dup = true;
+    seen[static_cast<std::size_t>(v)] = true;
+  }
+  EXPECT_FALSE(dup);
+  EXPECT_EQ(out.size(), static_cast<std::size_t>(kProducers * kPerProducer));
+}
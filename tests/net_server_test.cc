@@ -0,0 +1,127 @@
+#include "exynos/net/server.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/index/id_map.h"
+#include "exynos/jsonl/parser.h"
+#include "exytest.h"
+
+using exynos::cache::ColumnStore;
+using exynos::cache::ColumnStoreBuilder;
+using exynos::cache::ColumnType;
+using exynos::index::IdMap;
+using exynos::net::Client;
+using exynos::net::Server;
+
+namespace {
+
+constexpr const char* kCache = "net_server_test.exycol";
+constexpr const char* kSock = "net_server_test.sock";
+
+// 2000 rows with an id index: id req-N, latency N % 700.
+void build_store() {
+  ColumnStoreBuilder builder;
+  exynos::jsonl::Record rec;
+  IdMap ids;
+  for (int i = 0; i < 2000; ++i) {
+    std::string line = "{\"id\":\"req-" + std::to_string(i) +
+                       "\",\"latency_ms\":" + std::to_string(i % 700) + "}";
+    exynos::jsonl::parse_record(line, rec);
+    builder.add(rec);
+    ids.insert("req-" + std::to_string(i), static_cast<std::uint64_t>(i) * 64);
+  }
+  builder.set_id_index(ids);
+  builder.write(kCache, 1, 1);
+}
+
+}  // namespace
+
+TEST(lookup_batch_roundtrip_hits_and_misses) {
+  build_store();
+  ColumnStore store(kCache);
+  Server server(store, {kSock, -1});
+  Client client(kSock);
+
+  std::vector<std::string> keys;
+  std::vector<std::string_view> ids;
+  for (int i = 0; i < 500; ++i) keys.push_back("req-" + std::to_string(i * 3));
+  keys.push_back("req-9999");
+  keys.push_back("nope");
+  for (const std::string& k : keys) ids.push_back(k);
+
+  const std::vector<std::uint64_t> offsets = client.lookup_batch(ids);
+  EXPECT_EQ(offsets.size(), 502u);
+  for (int i = 0; i < 500; ++i)
+    EXPECT_EQ(offsets[i], static_cast<std::uint64_t>(i) * 3 * 64);
+  EXPECT_EQ(offsets[500], IdMap::kNotFound);
+  EXPECT_EQ(offsets[501], IdMap::kNotFound);
+  EXPECT_TRUE(server.requests_served() >= 1u);
+  std::remove(kCache);
+}
+
+TEST(column_slice_streams_store_bytes) {
+  build_store();
+  ColumnStore store(kCache);
+  Server server(store, {kSock, -1});
+  Client client(kSock);
+
+  const Client::Slice latency = client.column_slice("latency_ms", 100, 50);
+  EXPECT_TRUE(latency.type == ColumnType::Int64);
+  EXPECT_EQ(latency.bytes.size(), 50 * sizeof(std::int64_t));
+  const auto* vals = reinterpret_cast<const std::int64_t*>(latency.bytes.data());
+  for (int i = 0; i < 50; ++i) EXPECT_EQ(vals[i], (100 + i) % 700);
+
+  // Out-of-range tail clamps instead of erroring.
+  const Client::Slice tail = client.column_slice("latency_ms", 1990, 100);
+  EXPECT_EQ(tail.bytes.size(), 10 * sizeof(std::int64_t));
+
+  const Client::Slice codes = client.column_slice("id", 0, 4);
+  EXPECT_TRUE(codes.type == ColumnType::String);
+  EXPECT_EQ(codes.bytes.size(), 4 * sizeof(std::uint32_t));
+  std::remove(kCache);
+}
+
+TEST(errors_are_frames_not_disconnects) {
+  build_store();
+  ColumnStore store(kCache);
+  Server server(store, {kSock, -1});
+  Client client(kSock);
+
+  bool threw = false;
+  try {
+    client.column_slice("no_such_column", 0, 1);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+
+  // The connection survives an error response.
+  const std::vector<std::uint64_t> offsets = client.lookup_batch({{"req-7"}});
+  EXPECT_EQ(offsets[0], 7u * 64);
+  std::remove(kCache);
+}
+
+TEST(many_small_batches_on_one_connection) {
+  build_store();
+  ColumnStore store(kCache);
+  Server server(store, {kSock, -1});
+  Client client(kSock);
+
+  for (int round = 0; round < 200; ++round) {
+    std::vector<std::string> keys;
+    std::vector<std::string_view> ids;
+    for (int i = 0; i < 16; ++i)
+      keys.push_back("req-" + std::to_string((round * 16 + i) % 2000));
+    for (const std::string& k : keys) ids.push_back(k);
+    const std::vector<std::uint64_t> offsets = client.lookup_batch(ids);
+    for (int i = 0; i < 16; ++i)
+      EXPECT_EQ(offsets[i],
+                static_cast<std::uint64_t>((round * 16 + i) % 2000) * 64);
+  }
+  EXPECT_EQ(server.requests_served(), 200u);
+  std::remove(kCache);
+}
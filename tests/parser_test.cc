@@ -0,0 +1,61 @@
+#include "exynos/jsonl/parser.h"
+
+#include "exytest.h"
+
+using exynos::jsonl::parse_record;
+using exynos::jsonl::Record;
+using exynos::jsonl::ValueType;
+
+TEST(parses_typical_request_line) {
+  Record rec;
+  EXPECT_TRUE(parse_record(
+      R"({"id":"req-1","endpoint":"/api/v1/users","latency_ms":42,)"
+      R"("ok":true,"note":null})",
+      rec));
+  EXPECT_EQ(rec.fields.size(), 5u);
+  EXPECT_EQ(rec.find("id")->s, "req-1");
+  EXPECT_EQ(rec.find("latency_ms")->as_int(), 42);
+  EXPECT_EQ(rec.find("ok")->type, ValueType::Bool);
+  EXPECT_TRUE(rec.find("ok")->b);
+  EXPECT_EQ(rec.find("note")->type, ValueType::Null);
+  EXPECT_TRUE(rec.find("missing") == nullptr);
+}
+
+TEST(doubles_and_negative_numbers) {
+  Record rec;
+  EXPECT_TRUE(parse_record(R"({"a":-7,"b":1.5,"c":2e3})", rec));
+  EXPECT_EQ(rec.find("a")->as_int(), -7);
+  EXPECT_EQ(rec.find("b")->type, ValueType::Double);
+  EXPECT_TRUE(rec.find("b")->d == 1.5);
+  EXPECT_TRUE(rec.find("c")->d == 2000.0);
+}
+
+TEST(nested_values_captured_raw) {
+  Record rec;
+  EXPECT_TRUE(parse_record(R"({"meta":{"k":[1,2]},"tags":["a","b"]})", rec));
+  EXPECT_EQ(rec.find("meta")->type, ValueType::Raw);
+  EXPECT_EQ(rec.find("meta")->s, R"({"k":[1,2]})");
+  EXPECT_EQ(rec.find("tags")->s, R"(["a","b"])");
+}
+
+TEST(escaped_quotes_inside_strings) {
+  Record rec;
+  EXPECT_TRUE(parse_record(R"({"msg":"say \"hi\" now"})", rec));
+  EXPECT_EQ(rec.find("msg")->s, R"(say \"hi\" now)");
+}
+
+TEST(rejects_malformed_lines) {
+  Record rec;
+  EXPECT_FALSE(parse_record("", rec));
+  EXPECT_FALSE(parse_record("not json", rec));
+  EXPECT_FALSE(parse_record(R"({"a":)", rec));
+  EXPECT_FALSE(parse_record(R"({"a":1)", rec));
+  EXPECT_FALSE(parse_record(R"({"a" 1})", rec));
+}
+
+TEST(empty_object_is_valid) {
+  Record rec;
+  EXPECT_TRUE(parse_record("{}", rec));
+  EXPECT_TRUE(parse_record("  { }  ", rec));
+  EXPECT_EQ(rec.fields.size(), 0u);
+}
@@ -0,0 +1,79 @@
+#include "exynos/ingest/pipeline.h"
+
+#include <string>
+
+#include "exytest.h"
+
+using exynos::ingest::ParsedChunk;
+using exynos::ingest::Pipeline;
+using exynos::ingest::PipelineOptions;
+
+namespace {
+
+std::string make_log(int n) {
+  std::string log;
+  for (int i = 0; i < n; ++i) {
+    log += "{\"id\":\"req-" + std::to_string(i) +
+           "\",\"latency_ms\":" + std::to_string(i % 100) + "}\n";
+  }
+  return log;
+}
+
+}  // namespace
+
+TEST(chunks_are_record_aligned) {
+  std::string log = make_log(100);
+  auto chunks = Pipeline::split_chunks(log, 128);
+  EXPECT_TRUE(chunks.size() > 1);
+  std::size_t total = 0;
+  for (auto c : chunks) {
+    EXPECT_EQ(c.back(), '\n');
+    total += c.size();
+  }
+  EXPECT_EQ(total, log.size());
+}
+
+TEST(all_records_consumed_in_file_order) {
+  std::string log = make_log(1000);
+  PipelineOptions opts;
+  opts.workers = 4;
+  opts.chunk_bytes = 512;
+  opts.pin_cores = false;
+  Pipeline pipeline(opts);
+
+  int expected = 0;
+  std::size_t last_index = 0;
+  bool ordered = true;
+  pipeline.run(log, [&](ParsedChunk&& chunk) {
+    if (chunk.index < last_index) ordered = false;
+    last_index = chunk.index;
+    for (const auto& rec : chunk.records) {
+      std::string want = "req-" + std::to_string(expected++);
+      if (rec.find("id")->s != want) ordered = false;
+    }
+  });
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(expected, 1000);
+}
+
+TEST(malformed_lines_counted_not_fatal) {
+  std::string log = "{\"id\":\"a\"}\ngarbage\n{\"id\":\"b\"}\n";
+  PipelineOptions opts;
+  opts.workers = 1;
+  opts.pin_cores = false;
+  Pipeline pipeline(opts);
+  std::size_t records = 0, malformed = 0;
+  pipeline.run(log, [&](ParsedChunk&& chunk) {
+    records += chunk.records.size();
+    malformed += chunk.malformed;
+  });
+  EXPECT_EQ(records, 2u);
+  EXPECT_EQ(malformed, 1u);
+}
+
+TEST(empty_input_runs_cleanly) {
+  Pipeline pipeline;
+  bool called = false;
+  pipeline.run("", [&](ParsedChunk&&) { called = true; });
+  EXPECT_FALSE(called);
+}
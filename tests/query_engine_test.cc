@@ -0,0 +1,217 @@
+#include "exynos/query/engine.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "exytest.h"
+
+using exynos::cache::ColumnStore;
+using exynos::cache::ColumnStoreBuilder;
+using exynos::jsonl::parse_record;
+using exynos::jsonl::Record;
+using exynos::query::AggOp;
+using exynos::query::CmpOp;
+using exynos::query::Engine;
+using exynos::query::Query;
+
+namespace {
+
+constexpr const char* kCache = "query_engine_test.exycol";
+
+// 3000 rows: endpoint cycles /a,/b,/c; latency = row % 500.
+void build_store() {
+  ColumnStoreBuilder builder;
+  Record rec;
+  const char* endpoints[] = {"/a", "/b", "/c"};
+  for (int i = 0; i < 3000; ++i) {
+    std::string line = "{\"id\":\"req-" + std::to_string(i) +
+                       "\",\"endpoint\":\"" + endpoints[i % 3] +
+                       "\",\"latency_ms\":" + std::to_string(i % 500) + "}";
+    parse_record(line, rec);
+    builder.add(rec);
+  }
+  builder.write(kCache, 1, 1);
+}
+
+}  // namespace
+
+TEST(count_per_endpoint_with_latency_filter) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+
+  Query q;
+  q.filters.push_back({"latency_ms", CmpOp::Gt, 399, ""});
+  q.group_by = "endpoint";
+  auto result = engine.run(q);
+
+  // Per 1500-row half-cycle, rows with latency 400..499 = 100 per 500-block,
+  // 6 blocks of 500 => 600 selected rows, evenly split across 3 endpoints.
+  EXPECT_EQ(result.rows_scanned, 3000u);
+  EXPECT_EQ(result.rows_selected, 600u);
+  EXPECT_EQ(result.groups.size(), 3u);
+  for (const auto& g : result.groups) EXPECT_EQ(g.value, 200);
+  std::remove(kCache);
+}
+
+TEST(ungrouped_count_and_sum) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+
+  Query count;
+  count.filters.push_back({"endpoint", CmpOp::Eq, 0, "/a"});
+  auto r1 = engine.run(count);
+  EXPECT_EQ(r1.groups.size(), 1u);
+  EXPECT_EQ(r1.groups[0].value, 1000);
+
+  Query sum;
+  sum.agg = AggOp::Sum;
+  sum.agg_column = "latency_ms";
+  sum.filters.push_back({"latency_ms", CmpOp::Le, 1, ""});
+  auto r2 = engine.run(sum);
+  // latency values 0 and 1, each appearing 6 times: sum = 6.
+  EXPECT_EQ(r2.rows_selected, 12u);
+  EXPECT_EQ(r2.groups[0].value, 6);
+  std::remove(kCache);
+}
+
+TEST(min_max_aggregates) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+
+  Query q;
+  q.agg = AggOp::Max;
+  q.agg_column = "latency_ms";
+  q.group_by = "endpoint";
+  auto result = engine.run(q);
+  EXPECT_EQ(result.groups.size(), 3u);
+  for (const auto& g : result.groups) EXPECT_EQ(g.value, 499);
+
+  q.agg = AggOp::Min;
+  auto result2 = engine.run(q);
+  for (const auto& g : result2.groups) EXPECT_EQ(g.value, 0);
+  std::remove(kCache);
+}
+
+TEST(pooled_scan_matches_serial_scan) {
+  build_store();
+  ColumnStore store(kCache);
+  exynos::sched::StealPool pool(4);
+  Engine serial(store);
+  Engine parallel(store, &pool);
+
+  Query q;
+  q.filters.push_back({"latency_ms", CmpOp::Gt, 399, ""});
+  q.group_by = "endpoint";
+  auto a = serial.run(q);
+  auto b = parallel.run(q);
+  EXPECT_EQ(a.rows_selected, b.rows_selected);
+  EXPECT_EQ(a.groups.size(), b.groups.size());
+  for (std::size_t i = 0; i < a.groups.size(); ++i) {
+    EXPECT_EQ(a.groups[i].key, b.groups[i].key);
+    EXPECT_EQ(a.groups[i].value, b.groups[i].value);
+  }
+  std::remove(kCache);
+}
+
+TEST(absent_dictionary_value_short_circuits) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+  Query q;
+  q.filters.push_back({"endpoint", CmpOp::Eq, 0, "/nope"});
+  auto result = engine.run(q);
+  EXPECT_EQ(result.rows_selected, 0u);
+  EXPECT_TRUE(result.groups.empty());
+  std::remove(kCache);
+}
+
+TEST(bad_queries_rejected) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+
+  Query missing;
+  missing.filters.push_back({"nope", CmpOp::Eq, 1, ""});
+  bool threw = false;
+  try {
+    engine.run(missing);
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+
+  Query bad_group;
+  bad_group.group_by = "latency_ms";  // not a string column
+  threw = false;
+  try {
+    engine.run(bad_group);
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+  std::remove(kCache);
+}
+
+TEST(top_k_matches_exact_counts_on_small_dictionary) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+
+  Query q;
+  q.filters.push_back({"latency_ms", CmpOp::Gt, 399, ""});
+  q.group_by = "endpoint";
+  auto exact = engine.run(q);
+  auto approx = engine.top_k(q, 2);
+
+  // Three endpoints tie at 200; top-2 keeps the two smallest keys and
+  // the 3-entry dictionary is far below any sketch collision.
+  EXPECT_EQ(approx.rows_selected, exact.rows_selected);
+  EXPECT_EQ(approx.groups.size(), 2u);
+  EXPECT_EQ(approx.groups[0].key, exact.groups[0].key);
+  EXPECT_EQ(approx.groups[0].value, exact.groups[0].value);
+  std::remove(kCache);
+}
+
+TEST(top_k_requires_string_group_by) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+  Query q;
+  bool threw = false;
+  try {
+    engine.top_k(q, 5);  // no group_by
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+  std::remove(kCache);
+}
+
+TEST(distinct_counts_filtered_values) {
+  build_store();
+  ColumnStore store(kCache);
+  Engine engine(store);
+
+  Query all;
+  auto r1 = engine.distinct(all, "endpoint");
+  EXPECT_EQ(r1.groups.size(), 1u);
+  EXPECT_EQ(r1.groups[0].value, 3);
+
+  // Only /a rows survive the filter, so one distinct id prefix column:
+  // every id is unique, 1000 selected rows => estimate near 1000.
+  Query only_a;
+  only_a.filters.push_back({"endpoint", CmpOp::Eq, 0, "/a"});
+  auto r2 = engine.distinct(only_a, "id");
+  EXPECT_EQ(r2.rows_selected, 1000u);
+  EXPECT_TRUE(r2.groups[0].value > 950 && r2.groups[0].value < 1050);
+
+  Query absent;
+  absent.filters.push_back({"endpoint", CmpOp::Eq, 0, "/nope"});
+  auto r3 = engine.distinct(absent, "id");
+  EXPECT_EQ(r3.groups[0].value, 0);
+  std::remove(kCache);
+}
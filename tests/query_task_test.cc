@@ -0,0 +1,120 @@
+#include "exynos/query/task.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "exynos/cache/block_store.h"
+#include "exynos/cache/column_store.h"
+#include "exynos/jsonl/parser.h"
+#include "exynos/query/engine.h"
+#include "exytest.h"
+
+using exynos::query::CmpOp;
+using exynos::query::Query;
+using exynos::query::Task;
+
+namespace {
+
+constexpr const char* kCol = "query_task_test.exycol";
+constexpr const char* kBlk = "query_task_test.exyblk";
+
+void cleanup() {
+  std::remove(kCol);
+  std::remove(kBlk);
+}
+
+Task<int> make_value(int v) { co_return v; }
+
+Task<int> add_nested(int a, int b) {
+  const int x = co_await make_value(a);
+  const int y = co_await make_value(b);
+  co_return x + y;
+}
+
+Task<int> throws() {
+  co_await make_value(0);
+  throw std::runtime_error("boom");
+  co_return 0;  // unreachable; Task<T> requires a co_return on all paths
+}
+
+Task<std::thread::id> hop(exynos::sched::StealPool& pool) {
+  co_await exynos::query::schedule_on(pool);
+  co_return std::this_thread::get_id();
+}
+
+void build_block_file() {
+  exynos::cache::ColumnStoreBuilder builder;
+  exynos::jsonl::Record rec;
+  for (int i = 0; i < 400; ++i) {
+    const std::string line =
+        "{\"endpoint\":\"/api/ep-" + std::to_string(i % 5) +
+        "\",\"ts\":" + std::to_string(1000 + i) +
+        ",\"latency_ms\":" + std::to_string(i % 20) + "}";
+    EXPECT_TRUE(parse_record(line, rec));
+    builder.add(rec);
+  }
+  builder.write(kCol, 0, 0);
+  exynos::cache::ColumnStore source(kCol);
+  exynos::cache::BlockStoreWriter::write(
+      source, kBlk, {16, exynos::cache::BlockCodec::None});
+}
+
+}  // namespace
+
+TEST(task_returns_values_and_nests) {
+  EXPECT_EQ(make_value(7).get(), 7);
+  EXPECT_EQ(add_nested(3, 4).get(), 7);
+}
+
+TEST(task_propagates_exceptions) {
+  bool caught = false;
+  try {
+    throws().get();
+  } catch (const std::runtime_error&) {
+    caught = true;
+  }
+  EXPECT_TRUE(caught);
+}
+
+TEST(schedule_on_hops_to_a_worker) {
+  exynos::sched::StealPool pool(2);
+  EXPECT_NE(hop(pool).get(), std::this_thread::get_id());
+}
+
+TEST(async_block_scan_matches_sync) {
+  cleanup();
+  build_block_file();
+  exynos::cache::BlockStore blocks(kBlk);
+  exynos::sched::StealPool pool(2);
+
+  Query q;
+  q.filters.push_back({"latency_ms", CmpOp::Ge, 10, ""});
+  q.group_by = "endpoint";
+  const auto sync = run_blocks(blocks, q);
+  for (std::size_t window : {std::size_t{1}, std::size_t{4}, std::size_t{64}}) {
+    const auto async = run_blocks_async(blocks, q, pool, window);
+    EXPECT_EQ(async.rows_selected, sync.rows_selected);
+    EXPECT_EQ(async.blocks_skipped, sync.blocks_skipped);
+    EXPECT_EQ(async.groups.size(), sync.groups.size());
+    for (std::size_t i = 0; i < sync.groups.size(); ++i) {
+      EXPECT_EQ(async.groups[i].key, sync.groups[i].key);
+      EXPECT_EQ(async.groups[i].value, sync.groups[i].value);
+    }
+  }
+  cleanup();
+}
+
+TEST(async_scan_skips_via_zone_maps) {
+  cleanup();
+  build_block_file();
+  exynos::cache::BlockStore blocks(kBlk);
+  exynos::sched::StealPool pool(2);
+
+  Query q;
+  q.filters.push_back({"ts", CmpOp::Ge, 1384, ""});
+  const auto result = run_blocks_async(blocks, q, pool);
+  EXPECT_EQ(result.blocks_skipped, 24u);
+  EXPECT_EQ(result.rows_selected, 16u);
+  cleanup();
+}
@@ -0,0 +1,91 @@
+#include "exynos/jsonl/schema.h"
+
+#include <cstdint>
+#include <string_view>
+
+#include "exynos/jsonl/parser.h"
+#include "exytest.h"
+
+using exynos::jsonl::Schema;
+using exynos::jsonl::SchemaField;
+
+namespace {
+
+struct ReqRow {
+  std::string_view id;
+  std::string_view endpoint;
+  std::int64_t latency_ms = 0;
+  bool ok = false;
+};
+
+using ReqSchema = Schema<SchemaField<"id", &ReqRow::id>,
+                         SchemaField<"endpoint", &ReqRow::endpoint>,
+                         SchemaField<"latency_ms", &ReqRow::latency_ms>,
+                         SchemaField<"ok", &ReqRow::ok>>;
+
+}  // namespace
+
+TEST(schema_fills_packed_struct) {
+  ReqRow row;
+  EXPECT_TRUE(ReqSchema::parse(
+      R"({"id":"req-7","endpoint":"/api/x","latency_ms":-42,"ok":true})",
+      row));
+  EXPECT_EQ(row.id, "req-7");
+  EXPECT_EQ(row.endpoint, "/api/x");
+  EXPECT_EQ(row.latency_ms, -42);
+  EXPECT_TRUE(row.ok);
+}
+
+TEST(schema_is_order_independent) {
+  ReqRow row;
+  EXPECT_TRUE(ReqSchema::parse(
+      R"({"ok":false,"latency_ms":5,"endpoint":"/a","id":"req-0"})", row));
+  EXPECT_EQ(row.latency_ms, 5);
+  EXPECT_FALSE(row.ok);
+}
+
+TEST(schema_rejects_shape_mismatches) {
+  ReqRow row;
+  // Unknown key.
+  EXPECT_FALSE(ReqSchema::parse(
+      R"({"id":"a","endpoint":"/a","latency_ms":1,"ok":true,"x":1})", row));
+  // Missing field.
+  EXPECT_FALSE(ReqSchema::parse(R"({"id":"a","endpoint":"/a"})", row));
+  // Type mismatch: latency_ms is declared Int, not String or Double.
+  EXPECT_FALSE(ReqSchema::parse(
+      R"({"id":"a","endpoint":"/a","latency_ms":"9","ok":true})", row));
+  EXPECT_FALSE(ReqSchema::parse(
+      R"({"id":"a","endpoint":"/a","latency_ms":1.5,"ok":true})", row));
+  // Trailing garbage past the closing brace.
+  EXPECT_FALSE(ReqSchema::parse(
+      R"({"id":"a","endpoint":"/a","latency_ms":1,"ok":true} x)", row));
+  EXPECT_FALSE(ReqSchema::parse("not json", row));
+}
+
+TEST(schema_keeps_strings_escaped) {
+  // Same convention as parse_record: the view is the escaped contents.
+  ReqRow row;
+  EXPECT_TRUE(ReqSchema::parse(
+      R"({"id":"a\"b","endpoint":"/a","latency_ms":0,"ok":false})", row));
+  EXPECT_EQ(row.id, R"(a\"b)");
+}
+
+TEST(schema_mismatch_falls_back_to_generic) {
+  const std::string_view line =
+      R"({"id":"a","endpoint":"/a","latency_ms":1,"extra":{"n":1}})";
+  ReqRow row;
+  EXPECT_FALSE(ReqSchema::parse(line, row));
+  exynos::jsonl::Record rec;
+  EXPECT_TRUE(exynos::jsonl::parse_record(line, rec));
+  EXPECT_EQ(rec.fields.size(), 4u);
+}
+
+TEST(schema_double_member) {
+  struct LatRow {
+    double p99 = 0;
+  };
+  using LatSchema = Schema<SchemaField<"p99", &LatRow::p99>>;
+  LatRow row;
+  EXPECT_TRUE(LatSchema::parse(R"({"p99":1.5})", row));
+  EXPECT_EQ(row.p99, 1.5);
+}
@@ -0,0 +1,61 @@
+#include "exynos/jsonl/simd_scanner.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "exytest.h"
+
+using exynos::jsonl::ScalarScanPolicy;
+using exynos::jsonl::SimdScanner;
+
+namespace {
+
+std::vector<std::uint64_t> naive_find(std::string_view data, char c) {
+  std::vector<std::uint64_t> out;
+  for (std::size_t i = 0; i < data.size(); ++i)
+    if (data[i] == c) out.push_back(i);
+  return out;
+}
+
+}  // namespace
+
+TEST(newlines_match_naive_scan_on_random_data) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> byte(0, 255);
+  for (std::size_t len : {0u, 1u, 63u, 64u, 65u, 500u, 4096u}) {
+    std::string data(len, '\0');
+    for (auto& ch : data) ch = static_cast<char>(byte(rng));
+    std::vector<std::uint64_t> got;
+    SimdScanner<>::find_newlines(data, got);
+    EXPECT_EQ(got, naive_find(data, '\n'));
+  }
+}
+
+TEST(block_masks_flag_structural_bytes) {
+  std::string block(64, 'x');
+  block[0] = '\n';
+  block[5] = '"';
+  block[63] = '\\';
+  auto masks = SimdScanner<>::scan_block(block.data());
+  EXPECT_EQ(masks.newlines, 1ULL << 0);
+  EXPECT_EQ(masks.quotes, 1ULL << 5);
+  EXPECT_EQ(masks.backslashes, 1ULL << 63);
+}
+
+TEST(scalar_policy_explicitly) {
+  std::string data = "{\"id\":\"a\"}\n{\"id\":\"b\"}\n";
+  std::vector<std::uint64_t> nl, quotes;
+  SimdScanner<ScalarScanPolicy>::find_newlines(data, nl);
+  SimdScanner<ScalarScanPolicy>::find_char(data, '"', quotes);
+  EXPECT_EQ(nl, naive_find(data, '\n'));
+  EXPECT_EQ(quotes, naive_find(data, '"'));
+}
+
+TEST(tail_shorter_than_block_is_masked) {
+  std::string data = "abc\n";
+  std::vector<std::uint64_t> nl;
+  SimdScanner<>::find_newlines(data, nl);
+  EXPECT_EQ(nl.size(), 1u);
+  EXPECT_EQ(nl[0], 3u);
+}
@@ -0,0 +1,68 @@
+#include "exynos/jsonl/simd_text.h"
+
+#include <string>
+
+#include "exytest.h"
+
+using exynos::jsonl::simd_unescape;
+using exynos::jsonl::simd_validate_utf8;
+
+TEST(ascii_validates_across_blocks) {
+  std::string data;
+  for (int i = 0; i < 300; ++i) data += "plain ascii payload ";
+  EXPECT_TRUE(simd_validate_utf8(data));
+  EXPECT_TRUE(simd_validate_utf8(""));
+}
+
+TEST(well_formed_multibyte_validates) {
+  // 2-, 3- and 4-byte sequences, including one straddling a 64-byte
+  // block boundary.
+  std::string data(62, 'x');
+  data += "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9D\x84\x9E";
+  EXPECT_TRUE(simd_validate_utf8(data));
+}
+
+TEST(malformed_sequences_rejected) {
+  EXPECT_FALSE(simd_validate_utf8("\x80"));          // stray continuation
+  EXPECT_FALSE(simd_validate_utf8("\xC0\xAF"));      // overlong 2-byte
+  EXPECT_FALSE(simd_validate_utf8("\xE0\x80\x80"));  // overlong 3-byte
+  EXPECT_FALSE(simd_validate_utf8("\xED\xA0\x80"));  // UTF-16 surrogate
+  EXPECT_FALSE(simd_validate_utf8("\xF4\x90\x80\x80"));  // past U+10FFFF
+  EXPECT_FALSE(simd_validate_utf8("\xC3"));          // truncated at end
+  EXPECT_FALSE(simd_validate_utf8("ok\xE2\x82"));    // truncated 3-byte
+}
+
+TEST(unescape_passthrough_is_bulk_copied) {
+  std::string in;
+  for (int i = 0; i < 10; ++i) in += "no escapes in this span at all! ";
+  std::string out;
+  EXPECT_TRUE(simd_unescape(in, out));
+  EXPECT_EQ(out, in);
+}
+
+TEST(unescape_resolves_simple_escapes) {
+  std::string out;
+  EXPECT_TRUE(simd_unescape(R"(line\none\ttab \"quoted\" back\\slash \/)",
+                            out));
+  EXPECT_EQ(out, "line\none\ttab \"quoted\" back\\slash /");
+}
+
+TEST(unescape_decodes_unicode_escapes) {
+  std::string out;
+  EXPECT_TRUE(simd_unescape("caf\\u00e9 \\u20ac", out));
+  EXPECT_EQ(out, "caf\xC3\xA9 \xE2\x82\xAC");
+  // Surrogate pair: U+1D11E MUSICAL SYMBOL G CLEF.
+  EXPECT_TRUE(simd_unescape("\\uD834\\uDD1E", out));
+  EXPECT_EQ(out, "\xF0\x9D\x84\x9E");
+}
+
+TEST(unescape_rejects_malformed_escapes) {
+  std::string out;
+  EXPECT_FALSE(simd_unescape("dangling\\", out));
+  EXPECT_FALSE(simd_unescape("\\q", out));
+  EXPECT_FALSE(simd_unescape("\\u12G4", out));
+  EXPECT_FALSE(simd_unescape("\\u123", out));
+  EXPECT_FALSE(simd_unescape("\\uD834", out));         // unpaired high
+  EXPECT_FALSE(simd_unescape("\\uDD1E", out));         // unpaired low
+  EXPECT_FALSE(simd_unescape("\\uD834\\u0041", out));  // bad pair
+}
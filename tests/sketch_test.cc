@@ -0,0 +1,93 @@
+#include "exynos/query/sketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "exytest.h"
+
+using exynos::query::CountMinSketch;
+using exynos::query::HyperLogLog;
+using exynos::query::TopK;
+
+TEST(count_min_never_undercounts) {
+  CountMinSketch cms;
+  // A few heavy keys over a large noisy tail.
+  for (std::uint64_t k = 0; k < 8; ++k)
+    for (int i = 0; i < 1000; ++i) cms.add(k);
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 100000; ++i) cms.add(1000 + rng() % 1000000);
+
+  for (std::uint64_t k = 0; k < 8; ++k) {
+    const std::uint64_t est = cms.estimate(k);
+    EXPECT_TRUE(est >= 1000u);
+    // 100k tail adds over 8192 cells: collision noise stays small.
+    EXPECT_TRUE(est <= 1200u);
+  }
+}
+
+TEST(count_min_merge_sums_counts) {
+  CountMinSketch a, b;
+  a.add(7, 10);
+  b.add(7, 5);
+  a.merge(b);
+  EXPECT_EQ(a.estimate(7), 15u);
+
+  CountMinSketch tiny(16, 2);
+  bool threw = false;
+  try {
+    a.merge(tiny);
+  } catch (const std::invalid_argument&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+}
+
+TEST(top_k_finds_heavy_hitters_in_skewed_stream) {
+  // Keys 0..19 get 2000 - 50*k occurrences; 200k distinct light keys of
+  // one occurrence each form the tail.
+  std::vector<std::uint64_t> stream;
+  for (std::uint64_t k = 0; k < 20; ++k)
+    for (std::uint64_t i = 0; i < 2000 - 50 * k; ++i) stream.push_back(k);
+  for (std::uint64_t i = 0; i < 200000; ++i) stream.push_back(1000 + i);
+  std::mt19937_64 rng(7);
+  std::shuffle(stream.begin(), stream.end(), rng);
+
+  TopK top(10);
+  for (const std::uint64_t k : stream) top.add(k);
+  const auto items = top.items();
+  EXPECT_EQ(items.size(), 10u);
+  // The ten heaviest keys are exactly 0..9, in count order.
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    EXPECT_EQ(items[i].key, i);
+    EXPECT_TRUE(items[i].count >= 2000 - 50 * i);
+  }
+}
+
+TEST(hyperloglog_estimates_within_a_few_percent) {
+  HyperLogLog hll;
+  // Every key repeated three times: repeats must not inflate the count.
+  for (int pass = 0; pass < 3; ++pass)
+    for (std::uint64_t k = 0; k < 100000; ++k) hll.add(k);
+  const auto est = static_cast<double>(hll.estimate());
+  EXPECT_TRUE(std::abs(est - 100000.0) < 5000.0);
+}
+
+TEST(hyperloglog_small_counts_are_near_exact) {
+  HyperLogLog hll;
+  EXPECT_EQ(hll.estimate(), 0u);
+  for (std::uint64_t k = 0; k < 50; ++k) hll.add(k);
+  const std::uint64_t est = hll.estimate();
+  EXPECT_TRUE(est >= 48u && est <= 52u);
+}
+
+TEST(hyperloglog_merge_unions_streams) {
+  HyperLogLog a, b;
+  for (std::uint64_t k = 0; k < 50000; ++k) a.add(k);
+  for (std::uint64_t k = 25000; k < 75000; ++k) b.add(k);
+  a.merge(b);
+  const auto est = static_cast<double>(a.estimate());
+  EXPECT_TRUE(std::abs(est - 75000.0) < 4000.0);
+}
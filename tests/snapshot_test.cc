@@ -0,0 +1,126 @@
+#include "exynos/share/snapshot.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/index/id_map.h"
+#include "exynos/jsonl/parser.h"
+#include "exytest.h"
+
+using exynos::share::Snapshot;
+using exynos::share::SnapshotPublisher;
+
+namespace {
+
+constexpr const char* kControl = "snapshot_test.ctl";
+
+std::string build_exycol(const char* path, int rows) {
+  exynos::cache::ColumnStoreBuilder builder;
+  exynos::index::IdMap ids;
+  exynos::jsonl::Record rec;
+  for (int i = 0; i < rows; ++i) {
+    const std::string id = "req-" + std::to_string(i);
+    const std::string line =
+        "{\"id\":\"" + id + "\",\"n\":" + std::to_string(i) + "}";
+    EXPECT_TRUE(parse_record(line, rec));
+    builder.add(rec);
+    ids.insert(id, static_cast<std::uint64_t>(i) * 10);
+  }
+  builder.set_id_index(ids);
+  builder.write(path, 0, 0);
+  return path;
+}
+
+}  // namespace
+
+TEST(publish_and_attach_raw_bytes) {
+  SnapshotPublisher pub(kControl);
+  const char payload[] = "snapshot payload bytes";
+  const std::uint64_t epoch = pub.publish(payload, sizeof(payload));
+  EXPECT_TRUE(epoch > 0);
+  EXPECT_EQ(epoch & 1, 0u);
+
+  Snapshot snap = Snapshot::attach(kControl);
+  EXPECT_EQ(snap.epoch(), epoch);
+  EXPECT_EQ(snap.size(), sizeof(payload));
+  EXPECT_EQ(std::memcmp(snap.data(), payload, sizeof(payload)), 0);
+  EXPECT_FALSE(snap.stale());
+  std::remove(kControl);
+}
+
+TEST(attached_store_serves_columns_and_index) {
+  const std::string exycol = build_exycol("snapshot_test.exycol", 300);
+  SnapshotPublisher pub(kControl);
+  pub.publish_file(exycol);
+  std::remove(exycol.c_str());  // readers never touch the original file
+
+  Snapshot snap = Snapshot::attach(kControl);
+  exynos::cache::ColumnStore store = snap.open_store();
+  EXPECT_EQ(store.rows(), 300u);
+  auto col = store.find("n");
+  EXPECT_TRUE(col.has_value());
+  EXPECT_EQ(col->ints()[123], 123);
+  auto index = store.id_index();
+  EXPECT_TRUE(index.has_value());
+  EXPECT_EQ(*index->find("req-42"), 420u);
+  std::remove(kControl);
+}
+
+TEST(epoch_flip_marks_old_snapshot_stale) {
+  SnapshotPublisher pub(kControl);
+  pub.publish("one", 3);
+  Snapshot old_snap = Snapshot::attach(kControl);
+
+  pub.publish("twos", 4);
+  EXPECT_TRUE(old_snap.stale());
+  // The superseded mapping stays readable until the reader lets go.
+  EXPECT_EQ(std::memcmp(old_snap.data(), "one", 3), 0);
+
+  Snapshot fresh = Snapshot::attach(kControl);
+  EXPECT_TRUE(fresh.epoch() > old_snap.epoch());
+  EXPECT_EQ(fresh.size(), 4u);
+  EXPECT_EQ(std::memcmp(fresh.data(), "twos", 4), 0);
+  EXPECT_FALSE(fresh.stale());
+  std::remove(kControl);
+}
+
+TEST(attach_to_dead_publisher_throws) {
+  // A valid published epoch whose /proc fd window no longer resolves:
+  // the publisher process is gone, so attach must fail, not spin.
+  exynos::share::SnapshotControl ctrl{};
+  ctrl.magic = exynos::share::SnapshotControl::kMagic;
+  ctrl.seq = 2;
+  ctrl.pid = ::getpid();
+  ctrl.fd = 987654;  // no such descriptor in this process
+  ctrl.bytes = 64;
+  std::FILE* f = std::fopen(kControl, "wb");
+  EXPECT_TRUE(f != nullptr);
+  EXPECT_EQ(std::fwrite(&ctrl, sizeof(ctrl), 1, f), 1u);
+  std::fclose(f);
+
+  bool threw = false;
+  try {
+    Snapshot::attach(kControl);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+  std::remove(kControl);
+}
+
+TEST(attach_before_any_publish_throws) {
+  { SnapshotPublisher pub(kControl); }  // control exists, epoch still 0
+  bool threw = false;
+  try {
+    Snapshot::attach(kControl);
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+  std::remove(kControl);
+}
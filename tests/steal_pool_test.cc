@@ -0,0 +1,90 @@
+#include "exynos/sched/steal_pool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "exytest.h"
+
+using exynos::sched::StealPool;
+
+TEST(runs_all_submitted_tasks) {
+  StealPool pool(4);
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 1000; ++i)
+    pool.submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+  pool.wait_idle();
+  EXPECT_EQ(ran.load(), 1000);
+}
+
+TEST(tasks_can_spawn_tasks) {
+  StealPool pool(2);
+  std::atomic<int> ran{0};
+  pool.submit([&] {
+    for (int i = 0; i < 10; ++i)
+      pool.submit([&ran] { ran.fetch_add(1); });
+  });
+  pool.wait_idle();
+  EXPECT_EQ(ran.load(), 10);
+}
+
+TEST(throwing_task_surfaces_from_wait_idle) {
+  StealPool pool(2);
+  std::atomic<int> ran{0};
+  pool.submit([] { throw std::runtime_error("task failed"); });
+  for (int i = 0; i < 100; ++i)
+    pool.submit([&ran] { ran.fetch_add(1); });
+  bool threw = false;
+  try {
+    pool.wait_idle();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+  // The worker survived the throw and everything else still ran.
+  EXPECT_EQ(ran.load(), 100);
+  pool.wait_idle();  // error was consumed; idle pool returns clean
+}
+
+TEST(parallel_for_covers_every_index_once) {
+  StealPool pool(4);
+  std::vector<std::atomic<int>> counts(10000);
+  pool.parallel_for(counts.size(),
+                    [&](std::size_t i) { counts[i].fetch_add(1); });
+  bool all_once = true;
+  for (const auto& c : counts)
+    if (c.load() != 1) all_once = false;
+  EXPECT_TRUE(all_once);
+}
+
+TEST(weights_are_sane) {
+  StealPool pool(3);
+  EXPECT_EQ(pool.worker_count(), 3u);
+  for (unsigned w = 0; w < pool.worker_count(); ++w) {
+    EXPECT_TRUE(pool.weight(w) > 0.0);
+    EXPECT_TRUE(pool.weight(w) <= 1.0);
+  }
+}
+
+TEST(cluster_map_covers_every_worker) {
+  StealPool pool(4);
+  EXPECT_TRUE(pool.cluster_count() >= 1u);
+  for (unsigned w = 0; w < pool.worker_count(); ++w)
+    EXPECT_TRUE(pool.worker_cluster(w) < pool.cluster_count());
+}
+
+TEST(submit_on_cluster_runs_tasks) {
+  StealPool pool(4);
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 200; ++i)
+    pool.submit_on_cluster(static_cast<unsigned>(i) % pool.cluster_count(),
+                           [&ran] { ran.fetch_add(1); });
+  pool.wait_idle();
+  EXPECT_EQ(ran.load(), 200);
+}
+
+TEST(wait_idle_on_empty_pool_returns) {
+  StealPool pool(2);
+  pool.wait_idle();
+  EXPECT_TRUE(true);
+}
@@ -0,0 +1,75 @@
+#include "exynos/mem/string_pool.h"
+
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exytest.h"
+
+using exynos::mem::StringPool;
+
+TEST(intern_dedupes_and_round_trips) {
+  StringPool pool;
+  const std::uint32_t a = pool.intern("/api/login");
+  const std::uint32_t b = pool.intern("/api/logout");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(pool.intern("/api/login"), a);
+  EXPECT_EQ(pool.get(a), "/api/login");
+  EXPECT_EQ(pool.get(b), "/api/logout");
+  EXPECT_EQ(pool.size(), 2u);
+}
+
+TEST(find_does_not_insert) {
+  StringPool pool;
+  EXPECT_EQ(pool.find("missing"), StringPool::kNpos);
+  EXPECT_EQ(pool.size(), 0u);
+  const std::uint32_t id = pool.intern("present");
+  EXPECT_EQ(pool.find("present"), id);
+}
+
+TEST(ids_are_dense) {
+  StringPool pool;
+  for (int i = 0; i < 10000; ++i)
+    pool.intern("key-" + std::to_string(i));
+  EXPECT_EQ(pool.size(), 10000u);
+  // Every id below size() resolves; spot-check the slab boundary region.
+  std::set<std::string> seen;
+  for (std::uint32_t id = 0; id < pool.size(); ++id)
+    seen.insert(std::string(pool.get(id)));
+  EXPECT_EQ(seen.size(), 10000u);
+}
+
+TEST(copies_caller_bytes) {
+  StringPool pool;
+  std::uint32_t id;
+  {
+    std::string transient = "short-lived";
+    id = pool.intern(transient);
+    transient.assign(transient.size(), 'x');
+  }
+  EXPECT_EQ(pool.get(id), "short-lived");
+}
+
+TEST(concurrent_intern_agrees) {
+  StringPool pool;
+  constexpr int kThreads = 4;
+  constexpr int kKeys = 2000;
+  std::vector<std::vector<std::uint32_t>> ids(kThreads,
+                                              std::vector<std::uint32_t>(kKeys));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t)
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kKeys; ++i)
+        ids[static_cast<std::size_t>(t)][static_cast<std::size_t>(i)] =
+            pool.intern("/api/ep-" + std::to_string(i));
+    });
+  for (std::thread& th : threads) th.join();
+
+  EXPECT_EQ(pool.size(), static_cast<std::uint32_t>(kKeys));
+  for (int t = 1; t < kThreads; ++t)
+    EXPECT_TRUE(ids[0] == ids[static_cast<std::size_t>(t)]);
+  for (int i = 0; i < kKeys; ++i)
+    EXPECT_EQ(pool.get(ids[0][static_cast<std::size_t>(i)]),
+              "/api/ep-" + std::to_string(i));
+}
@@ -0,0 +1,136 @@
+#include "exynos/index/time_index.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "exynos/cache/column_store.h"
+#include "exynos/jsonl/parser.h"
+#include "exynos/query/engine.h"
+#include "exytest.h"
+
+using exynos::index::RowRange;
+using exynos::index::TimeIndex;
+
+namespace {
+
+bool ranges_cover(const std::vector<RowRange>& ranges, std::uint64_t row) {
+  for (const RowRange& r : ranges)
+    if (row >= r.begin && row < r.end) return true;
+  return false;
+}
+
+}  // namespace
+
+TEST(sorted_window_binary_searches_to_buckets) {
+  std::vector<std::int64_t> ts(10000);
+  for (std::size_t i = 0; i < ts.size(); ++i)
+    ts[i] = static_cast<std::int64_t>(i);
+  TimeIndex index(ts.data(), nullptr, ts.size());
+  EXPECT_TRUE(index.sorted());
+  EXPECT_EQ(index.min_ts(), 0);
+  EXPECT_EQ(index.max_ts(), 9999);
+
+  // Window inside buckets 1-2 coalesces into one range.
+  auto ranges = index.query(2000, 2100);
+  EXPECT_EQ(ranges.size(), 1u);
+  EXPECT_EQ(ranges[0].begin, 1024u);
+  EXPECT_EQ(ranges[0].end, 3072u);
+
+  EXPECT_TRUE(index.query(20000, 30000).empty());
+  EXPECT_TRUE(index.query(500, 400).empty());
+
+  // A full-span window returns everything.
+  ranges = index.query(0, 9999);
+  EXPECT_EQ(ranges.size(), 1u);
+  EXPECT_EQ(ranges[0].end, 10000u);
+}
+
+TEST(unsorted_data_degrades_to_zone_walk) {
+  // Two time regions out of order: the index must not binary search, but
+  // min/max pruning still has to return every matching row.
+  std::vector<std::int64_t> ts;
+  for (int i = 0; i < 3000; ++i) ts.push_back(50000 + i);
+  for (int i = 0; i < 3000; ++i) ts.push_back(10000 + i);
+  TimeIndex index(ts.data(), nullptr, ts.size());
+  EXPECT_FALSE(index.sorted());
+
+  auto ranges = index.query(10000, 10500);
+  for (std::size_t row = 0; row < ts.size(); ++row)
+    if (ts[row] >= 10000 && ts[row] <= 10500)
+      EXPECT_TRUE(ranges_cover(ranges, row));
+  // The first (later-time) region is pruned entirely.
+  EXPECT_FALSE(ranges_cover(ranges, 0));
+}
+
+TEST(null_timestamps_are_excluded) {
+  std::vector<std::int64_t> ts(2048, 0);
+  std::vector<std::uint8_t> valid(2048 / 8, 0);
+  // Only rows 1024..2047 carry timestamps; the first bucket is all-null.
+  for (std::size_t i = 1024; i < 2048; ++i) {
+    ts[i] = static_cast<std::int64_t>(i);
+    valid[i >> 3] |= static_cast<std::uint8_t>(1u << (i & 7));
+  }
+  TimeIndex index(ts.data(), valid.data(), ts.size());
+  EXPECT_EQ(index.min_ts(), 1024);
+  auto ranges = index.query(0, 100);  // only null rows hold 0
+  EXPECT_TRUE(ranges.empty());
+  ranges = index.query(1024, 1100);
+  EXPECT_EQ(ranges.size(), 1u);
+  EXPECT_EQ(ranges[0].begin, 1024u);
+}
+
+TEST(engine_prunes_with_attached_index) {
+  constexpr const char* kPath = "time_index_test.exycol";
+  exynos::cache::ColumnStoreBuilder builder;
+  exynos::jsonl::Record rec;
+  constexpr int kRows = 20000;
+  for (int i = 0; i < kRows; ++i) {
+    const std::string line = "{\"ts\":" + std::to_string(1000000 + i) +
+                             ",\"endpoint\":\"/api/" + std::to_string(i % 3) +
+                             "\",\"latency_ms\":" + std::to_string(i % 50) +
+                             "}";
+    EXPECT_TRUE(parse_record(line, rec));
+    builder.add(rec);
+  }
+  builder.write(kPath, 0, 0);
+  exynos::cache::ColumnStore store(kPath);
+
+  auto ts_col = store.find("ts");
+  TimeIndex index(ts_col->ints(), ts_col->valid_bits(), store.rows());
+
+  exynos::query::Query q;
+  q.filters.push_back(
+      {"ts", exynos::query::CmpOp::Ge, 1002000, ""});
+  q.filters.push_back(
+      {"ts", exynos::query::CmpOp::Le, 1002999, ""});
+  q.filters.push_back(
+      {"latency_ms", exynos::query::CmpOp::Lt, 10, ""});
+  q.group_by = "endpoint";
+
+  exynos::query::Engine full(store);
+  const exynos::query::Result expect = full.run(q);
+  EXPECT_EQ(expect.rows_pruned, 0u);
+
+  exynos::query::Engine pruned_engine(store);
+  pruned_engine.attach_time_index("ts", &index);
+  const exynos::query::Result got = pruned_engine.run(q);
+  EXPECT_TRUE(got.rows_pruned > 0u);
+  EXPECT_TRUE(got.rows_scanned < store.rows());
+  EXPECT_EQ(got.rows_selected, expect.rows_selected);
+  EXPECT_EQ(got.groups.size(), expect.groups.size());
+  for (std::size_t i = 0; i < got.groups.size(); ++i) {
+    EXPECT_EQ(got.groups[i].key, expect.groups[i].key);
+    EXPECT_EQ(got.groups[i].value, expect.groups[i].value);
+  }
+
+  // A window wholly outside the data scans nothing at all.
+  exynos::query::Query miss = q;
+  miss.filters[0].value = 5000000;
+  miss.filters[1].value = 5009999;
+  const exynos::query::Result none = pruned_engine.run(miss);
+  EXPECT_EQ(none.rows_scanned, 0u);
+  EXPECT_EQ(none.rows_selected, 0u);
+  std::remove(kPath);
+}
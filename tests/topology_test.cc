@@ -0,0 +1,98 @@
+#include "exynos/sched/topology.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+
+#include "exytest.h"
+
+using exynos::sched::Topology;
+
+namespace {
+
+constexpr const char* kRoot = "topology_test_sys";
+
+void write_file(const std::string& path, const std::string& body) {
+  std::FILE* f = std::fopen(path.c_str(), "w");
+  EXPECT_TRUE(f != nullptr);
+  std::fputs(body.c_str(), f);
+  std::fclose(f);
+}
+
+// Synthetic 2+2 big.LITTLE tree: cpus 0-1 on cluster 0 at 2.8 GHz with a
+// 1M L2, cpus 2-3 on cluster 1 at 1.8 GHz with a 512K L2.
+void build_fake_tree() {
+  for (int cpu = 0; cpu < 4; ++cpu) {
+    const std::string dir = std::string(kRoot) + "/cpu" + std::to_string(cpu);
+    ::mkdir(kRoot, 0755);
+    ::mkdir(dir.c_str(), 0755);
+    ::mkdir((dir + "/topology").c_str(), 0755);
+    ::mkdir((dir + "/cpufreq").c_str(), 0755);
+    ::mkdir((dir + "/cache").c_str(), 0755);
+    ::mkdir((dir + "/cache/index0").c_str(), 0755);
+    ::mkdir((dir + "/cache/index1").c_str(), 0755);
+    const bool big = cpu < 2;
+    write_file(dir + "/online", "1\n");
+    write_file(dir + "/topology/core_id", std::to_string(cpu) + "\n");
+    write_file(dir + "/topology/cluster_id", big ? "0\n" : "1\n");
+    write_file(dir + "/cpufreq/cpuinfo_max_freq",
+               big ? "2800000\n" : "1800000\n");
+    write_file(dir + "/cache/index0/level", "1\n");
+    write_file(dir + "/cache/index0/size", "64K\n");
+    write_file(dir + "/cache/index1/level", "2\n");
+    write_file(dir + "/cache/index1/size", big ? "1M\n" : "512K\n");
+  }
+}
+
+void remove_fake_tree() {
+  for (int cpu = 0; cpu < 4; ++cpu) {
+    const std::string dir = std::string(kRoot) + "/cpu" + std::to_string(cpu);
+    for (const char* f :
+         {"/online", "/topology/core_id", "/topology/cluster_id",
+          "/cpufreq/cpuinfo_max_freq", "/cache/index0/level",
+          "/cache/index0/size", "/cache/index1/level", "/cache/index1/size"})
+      std::remove((dir + f).c_str());
+    for (const char* d : {"/cache/index0", "/cache/index1", "/cache",
+                          "/cpufreq", "/topology", ""})
+      ::rmdir((dir + d).c_str());
+  }
+  ::rmdir(kRoot);
+}
+
+}  // namespace
+
+TEST(parses_clusters_freq_and_caches) {
+  build_fake_tree();
+  Topology topo(kRoot);
+  EXPECT_EQ(topo.cpu_count(), 4u);
+  EXPECT_EQ(topo.cluster_count(), 2u);
+  EXPECT_EQ(topo.cluster_of(0), topo.cluster_of(1));
+  EXPECT_EQ(topo.cluster_of(2), topo.cluster_of(3));
+  EXPECT_TRUE(topo.cluster_of(0) != topo.cluster_of(2));
+  EXPECT_EQ(topo.cpus_in(topo.cluster_of(2)).size(), 2u);
+  EXPECT_EQ(topo.max_freq_khz(0), 2800000);
+  EXPECT_EQ(topo.max_freq_khz(3), 1800000);
+  EXPECT_EQ(topo.llc_bytes(0), std::uint64_t{1} << 20);
+  EXPECT_EQ(topo.llc_bytes(2), std::uint64_t{512} << 10);
+  remove_fake_tree();
+}
+
+TEST(missing_tree_yields_single_cluster) {
+  Topology topo("topology_test_nonexistent");
+  EXPECT_TRUE(topo.cpu_count() >= 1u);
+  EXPECT_EQ(topo.cluster_count(), 1u);
+  EXPECT_EQ(topo.cluster_of(0), 0u);
+  EXPECT_EQ(topo.cpus_in(0).size(), topo.cpu_count());
+}
+
+TEST(system_singleton_is_consistent) {
+  const Topology& topo = Topology::system();
+  EXPECT_TRUE(topo.cpu_count() >= 1u);
+  EXPECT_TRUE(topo.cluster_count() >= 1u);
+  std::size_t members = 0;
+  for (unsigned c = 0; c < topo.cluster_count(); ++c)
+    members += topo.cpus_in(c).size();
+  EXPECT_EQ(members, topo.cpu_count());
+}
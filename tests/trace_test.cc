@@ -0,0 +1,75 @@
+#include "exynos/trace/trace.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "exytest.h"
+
+namespace {
+
+std::string dump_to_string() {
+  char buf[8192] = {};
+  std::FILE* f = fmemopen(buf, sizeof(buf) - 1, "w");
+  exynos::trace::dump(f);
+  std::fclose(f);
+  return buf;
+}
+
+void timed_work() {
+  EXYNOS_TRACE_SCOPE("trace_test.work");
+  volatile int x = 0;
+  for (int i = 0; i < 1000; ++i) x = x + i;
+}
+
+}  // namespace
+
+TEST(scope_records_into_dump) {
+  exynos::trace::reset();
+  for (int i = 0; i < 10; ++i) timed_work();
+  std::string out = dump_to_string();
+  EXPECT_TRUE(out.find("trace_test.work") != std::string::npos);
+}
+
+TEST(counters_aggregate_across_threads) {
+  exynos::trace::reset();
+  auto worker = [] {
+    EXYNOS_TRACE_COUNTER(events, "trace_test.events");
+    for (int i = 0; i < 100; ++i) events.add(2);
+  };
+  std::thread a(worker), b(worker);
+  a.join();
+  b.join();
+  std::string out = dump_to_string();
+  // 2 threads x 100 adds with value 2: count 200, total 400.
+  EXPECT_TRUE(out.find("trace_test.events") != std::string::npos);
+  EXPECT_TRUE(out.find("200") != std::string::npos);
+  EXPECT_TRUE(out.find("400") != std::string::npos);
+}
+
+TEST(reset_clears_recorded_data) {
+  exynos::trace::reset();
+  timed_work();
+  exynos::trace::reset();
+  std::string out = dump_to_string();
+  // Sites with zero count are omitted from the dump.
+  EXPECT_TRUE(out.find("trace_test.work") == std::string::npos);
+}
+
+TEST(disabled_specializations_are_empty) {
+  // The compiled-out variants must carry no state and do nothing.
+  exynos::trace::ScopeImpl<false> scope(nullptr);
+  exynos::trace::CounterImpl<false> counter(nullptr);
+  counter.add(123);
+  EXPECT_EQ(sizeof(scope), 1u);
+  EXPECT_EQ(sizeof(counter), 1u);
+}
+
+TEST(cycle_counter_is_monotonic) {
+  const std::uint64_t a = exynos::trace::cycles();
+  volatile int x = 0;
+  for (int i = 0; i < 10000; ++i) x = x + i;
+  const std::uint64_t b = exynos::trace::cycles();
+  EXPECT_TRUE(b >= a);
+}